@@ -0,0 +1,441 @@
+#include "common/cache.h"
+#include "common/io/io.h"
+#include "common/thread.h"
+#include "common/time.h"
+#include "util/path.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#if _WIN32
+    #include <windows.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__DragonFly__)
+    #include <sys/types.h>
+    #include <sys/sysctl.h>
+    #include <sys/time.h>
+#endif
+
+#define FF_CACHE_VERSION FASTFETCH_PROJECT_VERSION FASTFETCH_PROJECT_VERSION_TWEAK FASTFETCH_PROJECT_VERSION_GIT
+
+typedef struct FFCacheReader
+{
+    const char* pos;
+    const char* end;
+} FFCacheReader;
+
+// Identifies the current boot. Empty if it can't be detected, which disables the cache
+static const FFstrbuf* getBootId(void)
+{
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+    static FFstrbuf bootId;
+
+    FF_ONCE(&once)
+    {
+        ffStrbufInit(&bootId);
+
+        #if __linux__
+            if (ffReadFileBuffer("/proc/sys/kernel/random/boot_id", &bootId))
+                ffStrbufTrimRightSpace(&bootId);
+        #elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__DragonFly__)
+            struct timeval bootTime;
+            size_t size = sizeof(bootTime);
+            if (sysctl((int[]) { CTL_KERN, KERN_BOOTTIME }, 2, &bootTime, &size, NULL, 0) == 0 && size == sizeof(bootTime))
+                ffStrbufAppendF(&bootId, "%lld.%06ld", (long long) bootTime.tv_sec, (long) bootTime.tv_usec);
+        #endif
+    }
+
+    return &bootId;
+}
+
+static bool isHardwareCacheEnabled(void)
+{
+    return instance.config.general.hardwareCache && getBootId()->length > 0;
+}
+
+static bool getCachePath(const char* name, FFstrbuf* path)
+{
+    if (instance.state.platform.cacheDir.length == 0)
+        return false;
+
+    ffStrbufSet(path, &instance.state.platform.cacheDir);
+    ffStrbufAppendS(path, "fastfetch/");
+    ffStrbufAppendS(path, name);
+    return true;
+}
+
+// `bootId` is empty for entries that survive reboots
+static void appendHeader(FFstrbuf* buffer, const char* bootId, const void* key, uint32_t keySize)
+{
+    ffStrbufAppendNS(buffer, (uint32_t) sizeof(FF_CACHE_VERSION), FF_CACHE_VERSION);
+    ffStrbufAppendNS(buffer, (uint32_t) strlen(bootId) + 1, bootId);
+    ffStrbufAppendNS(buffer, sizeof(keySize), (const char*) &keySize);
+    ffStrbufAppendNS(buffer, keySize, key);
+}
+
+static void appendElement(FFstrbuf* buffer, const FFCacheField* fields, uint32_t fieldCount, const void* element)
+{
+    for (uint32_t i = 0; i < fieldCount; ++i)
+    {
+        const void* member = (const uint8_t*) element + fields[i].offset;
+        if (fields[i].isStrbuf)
+        {
+            const FFstrbuf* strbuf = member;
+            ffStrbufAppendNS(buffer, sizeof(strbuf->length), (const char*) &strbuf->length);
+            ffStrbufAppendNS(buffer, strbuf->length, strbuf->chars);
+        }
+        else
+            ffStrbufAppendNS(buffer, fields[i].size, member);
+    }
+}
+
+static bool readData(FFCacheReader* reader, uint32_t size, void* data)
+{
+    if ((size_t) (reader->end - reader->pos) < size)
+        return false;
+    if (data)
+        memcpy(data, reader->pos, size);
+    reader->pos += size;
+    return true;
+}
+
+// Validates the element only if `element` is NULL
+static bool readElement(FFCacheReader* reader, const FFCacheField* fields, uint32_t fieldCount, void* element)
+{
+    for (uint32_t i = 0; i < fieldCount; ++i)
+    {
+        void* member = element ? (uint8_t*) element + fields[i].offset : NULL;
+        if (fields[i].isStrbuf)
+        {
+            uint32_t length;
+            if (!readData(reader, sizeof(length), &length))
+                return false;
+            const char* chars = reader->pos;
+            if (!readData(reader, length, NULL))
+                return false;
+            if (member)
+                ffStrbufSetNS(member, length, chars);
+        }
+        else if (!readData(reader, fields[i].size, member))
+            return false;
+    }
+    return true;
+}
+
+// Returns a reader positioned after the header if the cache entry is valid
+static bool openEntry(const char* name, const char* bootId, const void* key, uint32_t keySize, FFstrbuf* content, FFCacheReader* reader)
+{
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    if (!getCachePath(name, &path) || !ffReadFileBuffer(path.chars, content))
+        return false;
+
+    FF_STRBUF_AUTO_DESTROY header = ffStrbufCreate();
+    appendHeader(&header, bootId, key, keySize);
+    if (content->length < header.length || memcmp(content->chars, header.chars, header.length) != 0)
+        return false;
+
+    *reader = (FFCacheReader) {
+        .pos = content->chars + header.length,
+        .end = content->chars + content->length,
+    };
+    return true;
+}
+
+// Written to a temporary file first, so that concurrent readers never see a partial entry
+static void writeEntry(const char* path, const FFstrbuf* content)
+{
+    FF_STRBUF_AUTO_DESTROY tempPath = ffStrbufCreateS(path);
+    #ifdef _WIN32
+        ffStrbufAppendF(&tempPath, ".%lu", (unsigned long) GetCurrentProcessId());
+    #else
+        ffStrbufAppendF(&tempPath, ".%ld", (long) getpid());
+    #endif
+    if (!ffWriteFileBuffer(tempPath.chars, content))
+        return;
+    #ifdef _WIN32
+        if (!MoveFileExA(tempPath.chars, path, MOVEFILE_REPLACE_EXISTING))
+            remove(tempPath.chars);
+    #else
+        if (rename(tempPath.chars, path) != 0)
+            remove(tempPath.chars);
+    #endif
+}
+
+static void saveEntry(const char* name, const FFstrbuf* content)
+{
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    if (getCachePath(name, &path))
+        writeEntry(path.chars, content);
+}
+
+static bool loadList(const char* name, const char* bootId, const void* key, uint32_t keySize, const FFCacheField* fields, uint32_t fieldCount, FFlist* result)
+{
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
+    FFCacheReader reader;
+    if (!openEntry(name, bootId, key, keySize, &content, &reader))
+        return false;
+
+    uint32_t count;
+    if (!readData(&reader, sizeof(count), &count))
+        return false;
+
+    FFCacheReader validator = reader;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (!readElement(&validator, fields, fieldCount, NULL))
+            return false;
+    }
+    if (validator.pos != validator.end)
+        return false;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        void* element = ffListAdd(result);
+        memset(element, 0, result->elementSize);
+        for (uint32_t j = 0; j < fieldCount; ++j)
+        {
+            if (fields[j].isStrbuf)
+                ffStrbufInit((FFstrbuf*) ((uint8_t*) element + fields[j].offset));
+        }
+        readElement(&reader, fields, fieldCount, element);
+    }
+    return true;
+}
+
+static void saveList(const char* name, const char* bootId, const void* key, uint32_t keySize, const FFCacheField* fields, uint32_t fieldCount, const FFlist* result)
+{
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
+    appendHeader(&content, bootId, key, keySize);
+    ffStrbufAppendNS(&content, sizeof(result->length), (const char*) &result->length);
+    for (uint32_t i = 0; i < result->length; ++i)
+        appendElement(&content, fields, fieldCount, ffListGet(result, i));
+    saveEntry(name, &content);
+}
+
+bool ffCacheLoadResult(const char* name, const void* key, uint32_t keySize, const FFCacheField* fields, uint32_t fieldCount, void* result)
+{
+    if (!isHardwareCacheEnabled())
+        return false;
+
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreateS("results/");
+    ffStrbufAppendS(&path, name);
+
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
+    FFCacheReader reader;
+    if (!openEntry(path.chars, getBootId()->chars, key, keySize, &content, &reader))
+        return false;
+
+    FFCacheReader validator = reader;
+    if (!readElement(&validator, fields, fieldCount, NULL) || validator.pos != validator.end)
+        return false;
+
+    return readElement(&reader, fields, fieldCount, result);
+}
+
+void ffCacheSaveResult(const char* name, const void* key, uint32_t keySize, const FFCacheField* fields, uint32_t fieldCount, const void* result)
+{
+    if (!isHardwareCacheEnabled())
+        return;
+
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreateS("results/");
+    ffStrbufAppendS(&path, name);
+
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
+    appendHeader(&content, getBootId()->chars, key, keySize);
+    appendElement(&content, fields, fieldCount, result);
+    saveEntry(path.chars, &content);
+}
+
+bool ffCacheLoadResultList(const char* name, const void* key, uint32_t keySize, const FFCacheField* fields, uint32_t fieldCount, FFlist* result)
+{
+    if (!isHardwareCacheEnabled())
+        return false;
+
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreateS("results/");
+    ffStrbufAppendS(&path, name);
+    return loadList(path.chars, getBootId()->chars, key, keySize, fields, fieldCount, result);
+}
+
+void ffCacheSaveResultList(const char* name, const void* key, uint32_t keySize, const FFCacheField* fields, uint32_t fieldCount, const FFlist* result)
+{
+    if (!isHardwareCacheEnabled())
+        return;
+
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreateS("results/");
+    ffStrbufAppendS(&path, name);
+    saveList(path.chars, getBootId()->chars, key, keySize, fields, fieldCount, result);
+}
+
+typedef struct FFExeVersionEntry
+{
+    FFstrbuf path;
+    uint64_t inode;
+    uint64_t size;
+    int64_t mtime;
+    FFstrbuf version;
+} FFExeVersionEntry;
+
+static const FFCacheField exeVersionFields[] = {
+    FF_CACHE_FIELD(FFExeVersionEntry, path),
+    FF_CACHE_FIELD(FFExeVersionEntry, inode),
+    FF_CACHE_FIELD(FFExeVersionEntry, size),
+    FF_CACHE_FIELD(FFExeVersionEntry, mtime),
+    FF_CACHE_FIELD(FFExeVersionEntry, version),
+};
+
+static struct
+{
+    FFThreadMutex mutex;
+    bool loaded;
+    FFlist entries; // FFExeVersionEntry
+} exeVersions = {
+    .mutex = FF_THREAD_MUTEX_INITIALIZER,
+};
+
+// Fills `entry` except its version. Returns false if the executable doesn't exist
+static bool statExe(const char* exe, FFExeVersionEntry* entry)
+{
+    if (ffIsAbsolutePath(exe))
+        ffStrbufSetS(&entry->path, exe);
+    else if (ffFindExecutableInPath(exe, &entry->path) != NULL)
+        return false;
+
+    struct stat st;
+    if (stat(entry->path.chars, &st) != 0)
+        return false;
+
+    entry->inode = (uint64_t) st.st_ino;
+    entry->size = (uint64_t) st.st_size;
+    entry->mtime = (int64_t) st.st_mtime;
+    return true;
+}
+
+// Must be called with `exeVersions.mutex` locked
+static FFExeVersionEntry* findExeVersion(const FFstrbuf* path)
+{
+    if (!exeVersions.loaded)
+    {
+        ffListInit(&exeVersions.entries, sizeof(FFExeVersionEntry));
+        loadList("versions", "", NULL, 0, exeVersionFields, ARRAY_SIZE(exeVersionFields), &exeVersions.entries);
+        exeVersions.loaded = true;
+    }
+
+    FF_LIST_FOR_EACH(FFExeVersionEntry, entry, exeVersions.entries)
+    {
+        if (ffStrbufEqual(&entry->path, path))
+            return entry;
+    }
+    return NULL;
+}
+
+bool ffCacheGetExeVersion(const char* exe, FFstrbuf* version)
+{
+    if (!instance.config.general.versionCache)
+        return false;
+
+    FFExeVersionEntry key = { .path = ffStrbufCreate() };
+    bool result = false;
+    if (statExe(exe, &key))
+    {
+        ffThreadMutexLock(&exeVersions.mutex);
+        FFExeVersionEntry* entry = findExeVersion(&key.path);
+        if (entry && entry->inode == key.inode && entry->size == key.size && entry->mtime == key.mtime)
+        {
+            ffStrbufSet(version, &entry->version);
+            result = true;
+        }
+        ffThreadMutexUnlock(&exeVersions.mutex);
+    }
+    ffStrbufDestroy(&key.path);
+    return result;
+}
+
+void ffCacheSetExeVersion(const char* exe, const FFstrbuf* version)
+{
+    if (!instance.config.general.versionCache || version->length == 0)
+        return;
+
+    FFExeVersionEntry key = { .path = ffStrbufCreate() };
+    if (statExe(exe, &key))
+    {
+        ffThreadMutexLock(&exeVersions.mutex);
+        FFExeVersionEntry* entry = findExeVersion(&key.path);
+        if (!entry)
+        {
+            entry = ffListAdd(&exeVersions.entries);
+            ffStrbufInitMove(&entry->path, &key.path);
+            ffStrbufInit(&entry->version);
+        }
+        entry->inode = key.inode;
+        entry->size = key.size;
+        entry->mtime = key.mtime;
+        ffStrbufSet(&entry->version, version);
+        saveList("versions", "", NULL, 0, exeVersionFields, ARRAY_SIZE(exeVersionFields), &exeVersions.entries);
+        ffThreadMutexUnlock(&exeVersions.mutex);
+    }
+    ffStrbufDestroy(&key.path);
+}
+
+// In ms since epoch
+static uint64_t getModifiedTime(const struct stat* st)
+{
+    #if defined(__APPLE__)
+        return (uint64_t) st->st_mtimespec.tv_sec * 1000 + (uint64_t) st->st_mtimespec.tv_nsec / 1000000;
+    #elif defined(_WIN32)
+        return (uint64_t) st->st_mtime * 1000;
+    #else
+        return (uint64_t) st->st_mtim.tv_sec * 1000 + (uint64_t) st->st_mtim.tv_nsec / 1000000;
+    #endif
+}
+
+bool ffCacheGetTtlPath(const char* dir, const FFstrbuf* key, FFstrbuf* path)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (uint32_t i = 0; i < key->length; ++i)
+        hash = (hash ^ (uint8_t) key->chars[i]) * 1099511628211ull;
+
+    FF_STRBUF_AUTO_DESTROY name = ffStrbufCreateS(dir);
+    ffStrbufAppendF(&name, "/%016llx", (unsigned long long) hash);
+    return getCachePath(name.chars, path);
+}
+
+FFCacheTtlStatus ffCacheLoadTtl(const char* path, uint32_t ttl, const FFstrbuf* keyFiles, FFstrbuf* value)
+{
+    struct stat st;
+    if (stat(path, &st) != 0)
+        return FF_CACHE_TTL_MISSING;
+    uint64_t storedTime = getModifiedTime(&st);
+
+    if (keyFiles && keyFiles->length > 0)
+    {
+        const char separator =
+            #ifdef _WIN32
+                ';';
+            #else
+                ':';
+            #endif
+
+        FF_STRBUF_AUTO_DESTROY keyFile = ffStrbufCreate();
+        for (uint32_t start = 0; start < keyFiles->length;)
+        {
+            uint32_t end = ffStrbufNextIndexC(keyFiles, start, separator);
+            ffStrbufSetNS(&keyFile, end - start, keyFiles->chars + start);
+            start = end + 1;
+
+            // Files that don't exist don't invalidate the entry
+            if (keyFile.length > 0 && stat(keyFile.chars, &st) == 0 && getModifiedTime(&st) >= storedTime)
+                return FF_CACHE_TTL_MISSING;
+        }
+    }
+
+    if (!ffReadFileBuffer(path, value))
+        return FF_CACHE_TTL_MISSING;
+
+    return ffTimeGetNow() - storedTime < (uint64_t) ttl * 1000 ? FF_CACHE_TTL_FRESH : FF_CACHE_TTL_STALE;
+}
+
+void ffCacheSaveTtl(const char* path, const FFstrbuf* value)
+{
+    writeEntry(path, value);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "fastfetch.h"
+
+#include <stddef.h>
+
+// A member of a result struct to be stored in the cache. FFstrbuf members are stored by content, others byte by byte
+typedef struct FFCacheField
+{
+    uint16_t offset;
+    uint16_t size;
+    bool isStrbuf;
+} FFCacheField;
+
+#define FF_CACHE_FIELD(type, member) { \
+    .offset = offsetof(type, member), \
+    .size = sizeof(((type*) NULL)->member), \
+    .isStrbuf = __builtin_types_compatible_p(__typeof__(((type*) NULL)->member), FFstrbuf), \
+}
+
+// Results that can't change without a reboot are stored in `<cacheDir>/fastfetch/results/<name>` if `general.hardwareCache` is enabled.
+// An entry is only valid for the current boot, fastfetch version and `key`, which should hold the module options that affect detection.
+// On success, the FFstrbuf members of `result`, which must be initialized, and all other members listed in `fields` are set.
+// `result` is untouched otherwise
+bool ffCacheLoadResult(const char* name, const void* key, uint32_t keySize, const FFCacheField* fields, uint32_t fieldCount, void* result);
+void ffCacheSaveResult(const char* name, const void* key, uint32_t keySize, const FFCacheField* fields, uint32_t fieldCount, const void* result);
+
+// Same as above, for lists of results. Elements are zero-initialized before their fields are set. `result` must be empty
+bool ffCacheLoadResultList(const char* name, const void* key, uint32_t keySize, const FFCacheField* fields, uint32_t fieldCount, FFlist* result);
+void ffCacheSaveResultList(const char* name, const void* key, uint32_t keySize, const FFCacheField* fields, uint32_t fieldCount, const FFlist* result);
+
+// Versions of executables, stored in `<cacheDir>/fastfetch/versions` if `general.versionCache` is enabled.
+// An entry is keyed by the path, inode, size and mtime of the executable, so that it's invalidated once the executable is updated.
+// `exe` is an absolute path, or a name to be looked up in PATH. Any other file that identifies the version can be used as well
+bool ffCacheGetExeVersion(const char* exe, FFstrbuf* version);
+void ffCacheSetExeVersion(const char* exe, const FFstrbuf* version);
+
+typedef enum __attribute__((__packed__)) FFCacheTtlStatus
+{
+    FF_CACHE_TTL_MISSING,
+    FF_CACHE_TTL_STALE,
+    FF_CACHE_TTL_FRESH,
+} FFCacheTtlStatus;
+
+// Values that expire after a time-to-live are stored verbatim in `<cacheDir>/fastfetch/<dir>/<hash of key>`.
+// Returns false if there is no cache dir
+bool ffCacheGetTtlPath(const char* dir, const FFstrbuf* key, FFstrbuf* path);
+
+// The mtime of the entry is the time it was stored. An entry is stale after `ttl` seconds,
+// and is treated as missing once any of `keyFiles`, separated by `:` (`;` on Windows), is modified after it was stored.
+// `value` is set unless the entry is missing
+FFCacheTtlStatus ffCacheLoadTtl(const char* path, uint32_t ttl, const FFstrbuf* keyFiles, FFstrbuf* value);
+void ffCacheSaveTtl(const char* path, const FFstrbuf* value);
@@ -1,14 +1,12 @@
 #include "commandoption.h"
-#include "common/color.h"
+#include "common/engine.h"
 #include "common/printing.h"
-#include "common/time.h"
 #include "common/jsonconfig.h"
 #include "fastfetch_datatext.h"
 #include "modules/modules.h"
 #include "util/stringUtils.h"
 
 #include <ctype.h>
-#include <inttypes.h>
 
 bool ffParseModuleOptions(const char* key, const char* value)
 {
@@ -22,29 +20,35 @@ bool ffParseModuleOptions(const char* key, const char* value)
     return false;
 }
 
+static FFModuleBaseInfo* findModuleInfo(const char* name)
+{
+    if(!ffCharIsEnglishAlphabet(name[0])) return NULL;
+
+    for (FFModuleBaseInfo** modules = ffModuleInfos[toupper(name[0]) - 'A']; *modules; ++modules)
+    {
+        if (ffStrEqualsIgnCase(name, (*modules)->name))
+            return *modules;
+    }
+    return NULL;
+}
+
 void ffPrepareCommandOption(FFdata* data)
 {
-    FFOptionsModules* const options = &instance.config.modules;
     //If we don't have a custom structure, use the default one
     if(data->structure.length == 0)
         ffStrbufAppendS(&data->structure, FASTFETCH_DATATEXT_STRUCTURE); // Cannot use `ffStrbufSetStatic` here because we will modify the string
 
-    if(ffStrbufContainIgnCaseS(&data->structure, FF_CPUUSAGE_MODULE_NAME))
-        ffPrepareCPUUsage();
-
-    if(ffStrbufContainIgnCaseS(&data->structure, FF_DISKIO_MODULE_NAME))
-        ffPrepareDiskIO(&options->diskIo);
-
-    if(ffStrbufContainIgnCaseS(&data->structure, FF_NETIO_MODULE_NAME))
-        ffPrepareNetIO(&options->netIo);
-
-    if(instance.config.general.multithreading)
+    //Parse the structure and queue the modules
+    uint32_t startIndex = 0;
+    while (startIndex < data->structure.length)
     {
-        if(ffStrbufContainIgnCaseS(&data->structure, FF_PUBLICIP_MODULE_NAME))
-            ffPreparePublicIp(&options->publicIP);
+        uint32_t colonIndex = ffStrbufNextIndexC(&data->structure, startIndex, ':');
+        data->structure.chars[colonIndex] = '\0';
+
+        const char* name = data->structure.chars + startIndex;
+        ffEngineAddModule(findModuleInfo(name), name, NULL);
 
-        if(ffStrbufContainIgnCaseS(&data->structure, FF_WEATHER_MODULE_NAME))
-            ffPrepareWeather(&options->weather);
+        startIndex = colonIndex + 1;
     }
 }
 
@@ -68,82 +72,9 @@ static void genJsonConfig(FFModuleBaseInfo* baseInfo, yyjson_mut_doc* doc)
         yyjson_mut_arr_add_strbuf(doc, modules, &type);
 }
 
-static void genJsonResult(FFModuleBaseInfo* baseInfo, yyjson_mut_doc* doc)
+void ffPrintCommandOption(FF_MAYBE_UNUSED FFdata* data, yyjson_mut_doc* jsonDoc)
 {
-    yyjson_mut_val* module = yyjson_mut_arr_add_obj(doc, doc->root);
-    yyjson_mut_obj_add_str(doc, module, "type", baseInfo->name);
-    if (baseInfo->generateJsonResult)
-        baseInfo->generateJsonResult(baseInfo, doc, module);
-    else
-        yyjson_mut_obj_add_str(doc, module, "error", "Unsupported for JSON format");
-}
-
-static void parseStructureCommand(
-    const char* line,
-    void (*fn)(FFModuleBaseInfo *baseInfo, yyjson_mut_doc* jsonDoc),
-    yyjson_mut_doc* jsonDoc
-)
-{
-    if(ffCharIsEnglishAlphabet(line[0]))
-    {
-        for (FFModuleBaseInfo** modules = ffModuleInfos[toupper(line[0]) - 'A']; *modules; ++modules)
-        {
-            FFModuleBaseInfo* baseInfo = *modules;
-            if (ffStrEqualsIgnCase(line, baseInfo->name))
-            {
-                if (__builtin_expect(jsonDoc != NULL, false))
-                    fn(baseInfo, jsonDoc);
-                else
-                    baseInfo->printModule(baseInfo);
-                return;
-            }
-        }
-    }
-
-    ffPrintError(line, 0, NULL, FF_PRINT_TYPE_NO_CUSTOM_KEY, "<no implementation provided>");
-}
-
-void ffPrintCommandOption(FFdata* data, yyjson_mut_doc* jsonDoc)
-{
-    //Parse the structure and call the modules
-    int32_t thres = instance.config.display.stat;
-    uint32_t startIndex = 0;
-    while (startIndex < data->structure.length)
-    {
-        uint32_t colonIndex = ffStrbufNextIndexC(&data->structure, startIndex, ':');
-        data->structure.chars[colonIndex] = '\0';
-
-        double ms = 0;
-        if(thres >= 0)
-            ms = ffTimeGetTick();
-
-        parseStructureCommand(data->structure.chars + startIndex, genJsonResult, jsonDoc);
-
-        if(thres >= 0)
-        {
-            ms = ffTimeGetTick() - ms;
-
-            if (jsonDoc)
-            {
-                yyjson_mut_val* moduleJson = yyjson_mut_arr_get_last(jsonDoc->root);
-                yyjson_mut_obj_add_real(jsonDoc, moduleJson, "stat", ms);
-            }
-            else
-            {
-                char str[64];
-                int len = snprintf(str, sizeof str, "%.3fms", ms);
-                if (thres > 0)
-                    snprintf(str, sizeof str, "\e[%sm%.3fms\e[m", (ms <= thres ? FF_COLOR_FG_GREEN : ms <= 2 * thres ? FF_COLOR_FG_YELLOW : FF_COLOR_FG_RED), ms);
-                printf("\e[s\e[1A\e[9999999C\e[%dD%s\e[u", len, str); // Save; Up 1; Right 9999999; Left <len>; Print <str>; Load
-            }
-        }
-
-        #if defined(_WIN32)
-            if (!jsonDoc && !instance.config.display.noBuffer) fflush(stdout);
-        #endif
-
-        startIndex = colonIndex + 1;
-    }
+    ffEngineRun(jsonDoc);
 }
 
 void ffMigrateCommandOptionToJsonc(FFdata* data, yyjson_mut_doc* jsonDoc)
@@ -159,7 +90,12 @@ void ffMigrateCommandOptionToJsonc(FFdata* data, yyjson_mut_doc* jsonDoc)
         uint32_t colonIndex = ffStrbufNextIndexC(&data->structure, startIndex, ':');
         data->structure.chars[colonIndex] = '\0';
 
-        parseStructureCommand(data->structure.chars + startIndex, genJsonConfig, jsonDoc);
+        const char* name = data->structure.chars + startIndex;
+        FFModuleBaseInfo* baseInfo = findModuleInfo(name);
+        if (baseInfo)
+            genJsonConfig(baseInfo, jsonDoc);
+        else
+            ffPrintError(name, 0, NULL, FF_PRINT_TYPE_NO_CUSTOM_KEY, "<no implementation provided>");
 
         startIndex = colonIndex + 1;
     }
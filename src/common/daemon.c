@@ -0,0 +1,359 @@
+#include "common/daemon.h"
+
+#ifdef _WIN32
+
+int ffDaemonServe(FF_MAYBE_UNUSED int (*run)(int argc, char** argv))
+{
+    fputs("Error: daemon mode is not supported on Windows\n", stderr);
+    return EXIT_FAILURE;
+}
+
+bool ffDaemonRequest(FF_MAYBE_UNUSED int argc, FF_MAYBE_UNUSED char** argv, FF_MAYBE_UNUSED int* status)
+{
+    return false;
+}
+
+#else
+
+#include "common/io/io.h"
+#include "detection/opencl/opencl.h"
+#include "detection/os/os.h"
+#include "detection/vulkan/vulkan.h"
+#include "util/mallocHelper.h"
+#include "util/smbiosHelper.h"
+#include "util/stringUtils.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#define FF_DAEMON_VERSION FASTFETCH_PROJECT_VERSION FASTFETCH_PROJECT_VERSION_TWEAK FASTFETCH_PROJECT_VERSION_GIT
+
+// Sent with stdin, stdout and stderr of the client attached, and followed by the payload
+typedef struct FFDaemonRequestHeader
+{
+    char version[64];
+    int32_t ppid;
+    uint32_t argc;
+    uint32_t envc;
+    uint32_t payloadSize; // Working directory, argv and environ, each null-terminated
+} FFDaemonRequestHeader;
+
+// The daemon replies `FF_DAEMON_ACCEPTED` once the request is validated, and the exit status when it's done.
+// The connection is closed without any reply if the request is refused, so that the client can run by itself
+#define FF_DAEMON_ACCEPTED ((uint8_t) 'A')
+
+static pid_t clientParentPid;
+static char socketPath[sizeof(((struct sockaddr_un*) NULL)->sun_path)];
+
+pid_t ffDaemonGetParentPid(void)
+{
+    return clientParentPid > 0 ? clientParentPid : getppid();
+}
+
+static bool getSocketAddress(struct sockaddr_un* addr)
+{
+    const char* runtimeDir = getenv("XDG_RUNTIME_DIR");
+    if (!runtimeDir || !*runtimeDir)
+        return false;
+
+    *addr = (struct sockaddr_un) { .sun_family = AF_UNIX };
+    int length = snprintf(addr->sun_path, sizeof(addr->sun_path), "%s/fastfetch.sock", runtimeDir);
+    return length > 0 && (size_t) length < sizeof(addr->sun_path);
+}
+
+static bool readAll(int fd, void* data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t nRead = read(fd, data, size);
+        if (nRead < 0 && errno == EINTR) continue;
+        if (nRead <= 0) return false;
+        data = (uint8_t*) data + nRead;
+        size -= (size_t) nRead;
+    }
+    return true;
+}
+
+static bool writeAll(int fd, const void* data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t nWritten = write(fd, data, size);
+        if (nWritten < 0 && errno == EINTR) continue;
+        if (nWritten <= 0) return false;
+        data = (const uint8_t*) data + nWritten;
+        size -= (size_t) nWritten;
+    }
+    return true;
+}
+
+bool ffDaemonRequest(int argc, char** argv, int* status)
+{
+    struct sockaddr_un addr;
+    if (!getSocketAddress(&addr))
+        return false;
+
+    FF_AUTO_CLOSE_FD int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0)
+        return false;
+    if (connect(sock, (struct sockaddr*) &addr, sizeof(addr)) < 0)
+        return false;
+
+    char cwd[PATH_MAX];
+    if (!getcwd(cwd, sizeof(cwd)))
+        return false;
+
+    extern char** environ;
+    FF_STRBUF_AUTO_DESTROY payload = ffStrbufCreateA(4096);
+    ffStrbufAppendNS(&payload, (uint32_t) strlen(cwd) + 1, cwd);
+    for (int i = 0; i < argc; ++i)
+        ffStrbufAppendNS(&payload, (uint32_t) strlen(argv[i]) + 1, argv[i]);
+    uint32_t envc = 0;
+    for (; environ[envc]; ++envc)
+        ffStrbufAppendNS(&payload, (uint32_t) strlen(environ[envc]) + 1, environ[envc]);
+
+    FFDaemonRequestHeader header = {
+        .version = FF_DAEMON_VERSION,
+        .ppid = (int32_t) getppid(),
+        .argc = (uint32_t) argc,
+        .envc = envc,
+        .payloadSize = payload.length,
+    };
+
+    int fds[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+    union {
+        struct cmsghdr header;
+        char buffer[CMSG_SPACE(sizeof(fds))];
+    } control = {};
+    struct msghdr msg = {
+        .msg_iov = &(struct iovec) { .iov_base = &header, .iov_len = sizeof(header) },
+        .msg_iovlen = 1,
+        .msg_control = control.buffer,
+        .msg_controllen = sizeof(control.buffer),
+    };
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    // The daemon may go away at any time. Don't get killed for that
+    struct sigaction oldAction;
+    sigaction(SIGPIPE, &(struct sigaction) { .sa_handler = SIG_IGN }, &oldAction);
+    bool sent = sendmsg(sock, &msg, 0) == (ssize_t) sizeof(header) && writeAll(sock, payload.chars, payload.length);
+    sigaction(SIGPIPE, &oldAction, NULL);
+
+    uint8_t reply;
+    if (!sent || !readAll(sock, &reply, 1) || reply != FF_DAEMON_ACCEPTED)
+        return false;
+
+    *status = readAll(sock, &reply, 1) ? reply : EXIT_FAILURE;
+    return true;
+}
+
+static bool isPeerTrusted(int conn)
+{
+    #if defined(__linux__)
+        struct ucred cred;
+        socklen_t length = sizeof(cred);
+        return getsockopt(conn, SOL_SOCKET, SO_PEERCRED, &cred, &length) == 0 && cred.uid == geteuid();
+    #elif defined(__sun) || defined(__HAIKU__)
+        return true; // Relies on the permissions of $XDG_RUNTIME_DIR and the socket
+    #else
+        uid_t uid;
+        gid_t gid;
+        return getpeereid(conn, &uid, &gid) == 0 && uid == geteuid();
+    #endif
+}
+
+static bool receiveRequest(int conn, FFDaemonRequestHeader* header, int fds[3], char** payload)
+{
+    union {
+        struct cmsghdr header;
+        char buffer[CMSG_SPACE(sizeof(int) * 3)];
+    } control = {};
+    struct msghdr msg = {
+        .msg_iov = &(struct iovec) { .iov_base = header, .iov_len = sizeof(*header) },
+        .msg_iovlen = 1,
+        .msg_control = control.buffer,
+        .msg_controllen = sizeof(control.buffer),
+    };
+
+    ssize_t received;
+    do
+        received = recvmsg(conn, &msg, 0);
+    while (received < 0 && errno == EINTR);
+
+    struct cmsghdr* cmsg = received > 0 ? CMSG_FIRSTHDR(&msg) : NULL;
+    if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(sizeof(int) * 3))
+        return false;
+    memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * 3);
+
+    if ((size_t) received < sizeof(*header) && !readAll(conn, (uint8_t*) header + received, sizeof(*header) - (size_t) received))
+        return false;
+    if (strncmp(header->version, FF_DAEMON_VERSION, sizeof(header->version)) != 0)
+        return false;
+
+    *payload = malloc(header->payloadSize + 1);
+    if (!readAll(conn, *payload, header->payloadSize))
+        return false;
+    (*payload)[header->payloadSize] = '\0';
+    return true;
+}
+
+// Splits null-terminated strings into `result`, which must be large enough to hold `count` strings and a NULL
+static bool splitStrings(char** cursor, const char* end, uint32_t count, char** result)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (*cursor >= end) return false;
+        result[i] = *cursor;
+        *cursor += strlen(*cursor) + 1;
+    }
+    result[count] = NULL;
+    return true;
+}
+
+// Runs in a process forked for the connection, which waits for the request to be done and reports its exit status
+static void serveRequest(int conn, int (*run)(int argc, char** argv))
+{
+    signal(SIGCHLD, SIG_DFL);
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+
+    if (!isPeerTrusted(conn))
+        _exit(EXIT_FAILURE);
+
+    FFDaemonRequestHeader header;
+    int fds[3] = { -1, -1, -1 };
+    char* payload = NULL;
+    if (!receiveRequest(conn, &header, fds, &payload))
+        _exit(EXIT_FAILURE);
+
+    char* cursor = payload;
+    const char* end = payload + header.payloadSize;
+    char* cwd = cursor;
+    cursor += strlen(cursor) + 1;
+    char** argv = malloc((header.argc + 1) * sizeof(*argv));
+    char** envp = malloc((header.envc + 1) * sizeof(*envp));
+    if (header.argc == 0 || !splitStrings(&cursor, end, header.argc, argv) || !splitStrings(&cursor, end, header.envc, envp))
+        _exit(EXIT_FAILURE);
+
+    uint8_t status = FF_DAEMON_ACCEPTED;
+    if (!writeAll(conn, &status, 1))
+        _exit(EXIT_FAILURE);
+
+    pid_t worker = fork();
+    if (worker == 0)
+    {
+        close(conn);
+        for (int i = 0; i < 3; ++i)
+        {
+            dup2(fds[i], i);
+            close(fds[i]);
+        }
+
+        extern char** environ;
+        environ = envp;
+        // Keep going if it has been removed, like a shell does
+        FF_MAYBE_UNUSED int ret = chdir(cwd);
+        clientParentPid = header.ppid;
+
+        exit(run((int) header.argc, argv));
+    }
+
+    int stat_loc = 0;
+    if (worker > 0 && waitpid(worker, &stat_loc, 0) == worker && WIFEXITED(stat_loc))
+        status = (uint8_t) WEXITSTATUS(stat_loc);
+    else
+        status = EXIT_FAILURE;
+    writeAll(conn, &status, 1);
+    _exit(EXIT_SUCCESS);
+}
+
+static void exitSignalHandler(FF_MAYBE_UNUSED int signal)
+{
+    unlink(socketPath);
+    _exit(EXIT_SUCCESS);
+}
+
+int ffDaemonServe(int (*run)(int argc, char** argv))
+{
+    struct sockaddr_un addr;
+    if (!getSocketAddress(&addr))
+    {
+        fputs("Error: $XDG_RUNTIME_DIR must be set for daemon mode\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0)
+    {
+        perror("socket()");
+        return EXIT_FAILURE;
+    }
+    fcntl(listenFd, F_SETFD, FD_CLOEXEC);
+
+    if (connect(listenFd, (struct sockaddr*) &addr, sizeof(addr)) == 0)
+    {
+        fprintf(stderr, "Error: another daemon is listening on %s\n", addr.sun_path);
+        return EXIT_FAILURE;
+    }
+    unlink(addr.sun_path); // Stale socket of a daemon that was killed
+
+    mode_t oldMask = umask(0077);
+    int ret = bind(listenFd, (struct sockaddr*) &addr, sizeof(addr));
+    umask(oldMask);
+    if (ret < 0 || listen(listenFd, 16) < 0)
+    {
+        perror(addr.sun_path);
+        return EXIT_FAILURE;
+    }
+    ffStrCopy(socketPath, addr.sun_path, sizeof(socketPath));
+
+    // Results memoized here are inherited by every request. Only detections that don't depend on
+    // the client (terminal, environment, options) and that don't change while the system is running are warmed up
+    ffInitInstance();
+    ffDetectOS();
+    #if defined(__linux__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__sun) || defined(__HAIKU__) || defined(__OpenBSD__)
+    ffGetSmbiosHeaderTable();
+    #endif
+    ffDetectVulkan();
+    ffDetectOpenCL();
+    ffDestroyInstance();
+
+    struct sigaction action = { .sa_handler = exitSignalHandler };
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGCHLD, SIG_IGN); // Connection processes are reaped automatically
+
+    fflush(NULL);
+
+    while (true)
+    {
+        int conn = accept(listenFd, NULL, NULL);
+        if (conn < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            perror("accept()");
+            break;
+        }
+
+        if (fork() == 0)
+        {
+            close(listenFd);
+            serveRequest(conn, run);
+        }
+        close(conn);
+    }
+
+    unlink(socketPath);
+    return EXIT_FAILURE;
+}
+
+#endif
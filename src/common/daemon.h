@@ -0,0 +1,17 @@
+#pragma once
+
+#include "fastfetch.h"
+
+// Listens on `$XDG_RUNTIME_DIR/fastfetch.sock`, and runs `run` for each request in a process forked from the daemon.
+// Detection results memoized by the daemon, such as OS, Vulkan, OpenCL and SMBIOS, are inherited by every request,
+// while everything else is detected freshly. Returns only on failure
+int ffDaemonServe(int (*run)(int argc, char** argv));
+
+// Sends the command line, environment, working directory and stdio of the current process to the daemon, which runs it.
+// Returns false if the daemon can't be reached or refuses the request; `*status` receives the exit status otherwise
+bool ffDaemonRequest(int argc, char** argv, int* status);
+
+#ifndef _WIN32
+// The parent of the client when serving a request, otherwise the parent of the current process
+pid_t ffDaemonGetParentPid(void);
+#endif
@@ -26,14 +26,11 @@ static bool loadLibSymbols(FFDBusLibrary* lib)
 static const FFDBusLibrary* loadLib(void)
 {
     static FFDBusLibrary lib;
-    static bool loaded = false;
     static bool loadSuccess = false;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
 
-    if(!loaded)
-    {
-        loaded = true;
+    FF_ONCE(&once)
         loadSuccess = loadLibSymbols(&lib);
-    }
 
     return loadSuccess ? &lib : NULL;
 }
@@ -0,0 +1,438 @@
+#include "fastfetch.h"
+#include "common/color.h"
+#include "common/engine.h"
+#include "common/io/io.h"
+#include "common/printing.h"
+#include "common/thread.h"
+#include "common/time.h"
+
+#include <stdlib.h>
+
+typedef struct FFEngineJob
+{
+    FFModuleBaseInfo* baseInfo;
+    const char* name;
+    yyjson_val* module;
+    bool dispatched; // Options have been parsed. Accessed by main thread only
+    bool detected; // Accessed by main thread only
+    bool printed; // Accessed by main thread only
+    bool abandoned; // Timed out while detecting. Accessed by main thread only
+    uint32_t timeout; // Per-module timeout in ms, 0 for none
+    double deadline; // Tick when the printing thread stops waiting for the detection, 0 for none
+    double detectionTime;
+    #ifdef FF_HAVE_THREADS
+    FFThreadFuture* future; // Set while being detected on the thread pool
+    #endif
+} FFEngineJob;
+
+static FFlist jobs;
+
+#ifdef FF_HAVE_THREADS
+static struct
+{
+    bool running; // Detections run on the thread pool
+    bool abandoned; // Some detections may never finish
+    double deadline; // Global deadline, 0 for none
+} engine; // Accessed by main thread only
+
+static void detectJob(void* data)
+{
+    FFEngineJob* job = data;
+    double start = ffTimeGetTick();
+    job->baseInfo->detectModule(job->baseInfo);
+    job->detectionTime = ffTimeGetTick() - start;
+}
+#endif
+
+void ffEngineAddModule(FFModuleBaseInfo* baseInfo, const char* name, yyjson_val* module)
+{
+    if (jobs.elementSize == 0)
+        ffListInit(&jobs, sizeof(FFEngineJob));
+
+    if (baseInfo && baseInfo->prepareModule)
+    {
+        if (module)
+            baseInfo->parseJsonObject(baseInfo, module);
+        baseInfo->prepareModule(baseInfo);
+    }
+
+    *(FFEngineJob*) ffListAdd(&jobs) = (FFEngineJob) {
+        .baseInfo = baseInfo,
+        .name = name,
+        .module = module,
+        .dispatched = baseInfo == NULL,
+        .detected = baseInfo == NULL,
+        .timeout = (uint32_t) yyjson_get_uint(yyjson_obj_get(module, "timeout")),
+    };
+}
+
+static void dispatchJob(FFEngineJob* job)
+{
+    job->dispatched = true;
+    if (job->module)
+        job->baseInfo->parseJsonObject(job->baseInfo, job->module);
+
+    #ifdef FF_HAVE_THREADS
+    if (engine.running && job->baseInfo->detectModule)
+    {
+        job->deadline = engine.deadline;
+        if (job->timeout > 0)
+        {
+            double deadline = ffTimeGetTick() + job->timeout;
+            if (job->deadline == 0 || deadline < job->deadline)
+                job->deadline = deadline;
+        }
+
+        job->future = ffThreadPoolSubmit(detectJob, job);
+        if (job->future)
+            return;
+    }
+    #endif
+
+    // Detected when printing
+    job->detected = true;
+}
+
+#ifdef FF_HAVE_THREADS
+// Dispatches every job whose module is not used by an earlier job that hasn't been printed or has been abandoned,
+// because all occurrences of a module share the same options and detection result
+static void dispatchJobs(void)
+{
+    for (uint32_t i = 0; i < jobs.length; ++i)
+    {
+        FFEngineJob* job = FF_LIST_GET(FFEngineJob, jobs, i);
+        if (job->dispatched)
+            continue;
+
+        bool blocked = false;
+        for (uint32_t j = 0; j < i && !blocked; ++j)
+        {
+            FFEngineJob* other = FF_LIST_GET(FFEngineJob, jobs, j);
+            blocked = other->baseInfo == job->baseInfo && (!other->printed || other->abandoned);
+        }
+
+        if (!blocked)
+            dispatchJob(job);
+    }
+}
+
+// At least 1, because 0 means no timeout
+static uint32_t getRemainingTime(double deadline)
+{
+    double remaining = deadline - ffTimeGetTick();
+    return remaining < 1 ? 1 : (uint32_t) remaining + 1;
+}
+
+// Collects the detection result if the job has been detected on the thread pool
+static bool isJobDetected(FFEngineJob* job)
+{
+    if (job->future && ffThreadFutureIsDone(job->future))
+    {
+        ffThreadFutureWait(job->future, 0);
+        job->future = NULL;
+        job->detected = true;
+    }
+    return job->detected;
+}
+
+// Returns false if the job is not detected before its deadline
+static bool waitForJob(FFEngineJob* job)
+{
+    // Never dispatched because an earlier occurrence of the module has been abandoned
+    if (!job->dispatched)
+        return false;
+
+    if (isJobDetected(job))
+        return true;
+
+    // Show the modules printed so far while we are waiting, instead of when stdout buffer is full
+    if (!instance.config.display.noBuffer)
+        fflush(stdout);
+
+    // Allow detections to suppress IO while we are waiting
+    ffStdioUnlock();
+    bool detected = ffThreadFutureWait(job->future, job->deadline == 0 ? 0 : getRemainingTime(job->deadline));
+    job->future = NULL;
+    job->detected = detected;
+
+    // A detection thread may hold the stdio lock for as long as it wants
+    if (detected && ffStdioTimedLock(job->deadline == 0 ? 0 : getRemainingTime(job->deadline)))
+        return true;
+
+    // Stop waiting for detections at all
+    engine.abandoned = true;
+    ffStdioReclaim();
+    return detected;
+}
+
+static void abandonJob(FFEngineJob* job, yyjson_mut_doc* jsonDoc)
+{
+    job->printed = true;
+    job->abandoned = true;
+
+    if (jsonDoc)
+    {
+        yyjson_mut_val* module = yyjson_mut_arr_add_obj(jsonDoc, jsonDoc->root);
+        yyjson_mut_obj_add_str(jsonDoc, module, "type", job->baseInfo->name);
+        yyjson_mut_obj_add_str(jsonDoc, module, "error", "Detection timed out");
+        return;
+    }
+
+    const FFstrbuf* placeholder = &instance.config.general.deadlinePlaceholder;
+    // Every module that has `detectModule` has `moduleArgs` right after its base info
+    const FFModuleArgs* moduleArgs = (const FFModuleArgs*) (job->baseInfo + 1);
+    if (placeholder->length == 0)
+        ffPrintError(job->baseInfo->name, 0, moduleArgs, FF_PRINT_TYPE_DEFAULT, "Detection timed out");
+    else
+    {
+        ffPrintLogoAndKey(job->baseInfo->name, 0, moduleArgs, FF_PRINT_TYPE_DEFAULT);
+        ffStrbufPutTo(placeholder, stdout);
+    }
+}
+
+#endif
+
+void ffEngineStart(void)
+{
+    #ifdef FF_HAVE_THREADS
+    bool detectable = false;
+    FF_LIST_FOR_EACH(FFEngineJob, job, jobs)
+    {
+        if (job->baseInfo && job->baseInfo->detectModule)
+        {
+            detectable = true;
+            break;
+        }
+    }
+    if (!detectable)
+        return;
+
+    if (instance.config.general.deadline > 0)
+        engine.deadline = ffTimeGetTick() + instance.config.general.deadline;
+
+    // Main thread prints all the time except when waiting for detection results
+    ffStdioLock();
+    engine.running = true;
+    dispatchJobs();
+    #endif
+}
+
+static void genJsonResult(FFModuleBaseInfo* baseInfo, yyjson_mut_doc* doc)
+{
+    yyjson_mut_val* module = yyjson_mut_arr_add_obj(doc, doc->root);
+    yyjson_mut_obj_add_str(doc, module, "type", baseInfo->name);
+    if (baseInfo->generateJsonResult)
+        baseInfo->generateJsonResult(baseInfo, doc, module);
+    else
+        yyjson_mut_obj_add_str(doc, module, "error", "Unsupported for JSON format");
+}
+
+static void printStat(double ms, yyjson_mut_doc* jsonDoc)
+{
+    if (jsonDoc)
+    {
+        yyjson_mut_val* moduleJson = yyjson_mut_arr_get_last(jsonDoc->root);
+        yyjson_mut_obj_add_real(jsonDoc, moduleJson, "stat", ms);
+    }
+    else
+    {
+        int32_t thres = instance.config.display.stat;
+        char str[64];
+        int len = snprintf(str, sizeof str, "%.3fms", ms);
+        if (thres > 0)
+            snprintf(str, sizeof str, "\e[%sm%.3fms\e[m", (ms <= thres ? FF_COLOR_FG_GREEN : ms <= 2 * thres ? FF_COLOR_FG_YELLOW : FF_COLOR_FG_RED), ms);
+        printf("\e[s\e[1A\e[9999999C\e[%dD%s\e[u", len, str); // Save; Up 1; Right 9999999; Left <len>; Print <str>; Load
+    }
+}
+
+static void printJob(FFEngineJob* job, yyjson_mut_doc* jsonDoc)
+{
+    double ms = 0;
+    if (instance.config.display.stat >= 0)
+        ms = ffTimeGetTick();
+
+    if (!job->baseInfo)
+        ffPrintError(job->name, 0, NULL, FF_PRINT_TYPE_NO_CUSTOM_KEY, "<no implementation provided>");
+    else if (__builtin_expect(jsonDoc != NULL, false))
+        genJsonResult(job->baseInfo, jsonDoc);
+    else
+        job->baseInfo->printModule(job->baseInfo);
+    job->printed = true;
+
+    if (instance.config.display.stat >= 0)
+        printStat(ffTimeGetTick() - ms + job->detectionTime, jsonDoc);
+
+    #if defined(_WIN32)
+    if (!jsonDoc && !instance.config.display.noBuffer) fflush(stdout);
+    #endif
+}
+
+#ifdef FF_HAVE_THREADS
+typedef struct FFEngineOutput
+{
+    FFstrbuf text; // Captured output, with the cursor at the start of the row
+    uint32_t row; // Value of `instance.state.keysHeight` before printing
+    uint32_t lines;
+    bool pending; // `text` is a placeholder
+} FFEngineOutput;
+
+// Prints the job into `output`, or a placeholder if `pending` is true. Returns false if stdout can't be captured
+static bool captureJob(FFEngineJob* job, FFEngineOutput* output, bool pending, bool abandoned)
+{
+    if (!ffStdioBeginCapture())
+        return false;
+
+    output->pending = pending;
+    uint32_t keysHeight = instance.state.keysHeight;
+    if (pending)
+    {
+        // Every module that has `detectModule` has `moduleArgs` right after its base info
+        ffPrintLogoAndKey(job->baseInfo->name, 0, (const FFModuleArgs*) (job->baseInfo + 1), FF_PRINT_TYPE_DEFAULT);
+        puts("...");
+    }
+    else if (abandoned)
+        abandonJob(job, NULL);
+    else
+        printJob(job, NULL);
+
+    ffStrbufClear(&output->text);
+    ffStdioEndCapture(&output->text);
+    output->lines = instance.state.keysHeight - keysHeight;
+    instance.state.keysHeight = keysHeight;
+    return true;
+}
+
+// Prints the outputs starting at `from`, whose row must be the current row
+static void putOutputs(FFEngineOutput* outputs, uint32_t count, uint32_t from)
+{
+    for (uint32_t i = from; i < count; ++i)
+    {
+        FFEngineOutput* output = &outputs[i];
+        output->row = instance.state.keysHeight;
+        instance.state.keysHeight += output->lines;
+
+        // Clear the rest of each row, which may contain the output previously printed there
+        const char* line = output->text.chars;
+        for (const char* end; (end = strchr(line, '\n')) != NULL; line = end + 1)
+        {
+            fwrite(line, 1, (size_t) (end - line), stdout);
+            fputs("\e[K\n", stdout);
+        }
+        fputs(line, stdout);
+    }
+}
+
+// Prints the remaining jobs at once, with placeholders for the ones that are not detected yet.
+// Placeholders are then replaced in place, by moving the cursor up and redrawing the rows below.
+// Returns false if it's not supported
+static bool printProgressively(uint32_t first)
+{
+    uint32_t count = jobs.length - first;
+    FFEngineOutput* outputs = calloc(count, sizeof(*outputs));
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        FFEngineJob* job = FF_LIST_GET(FFEngineJob, jobs, first + i);
+        ffStrbufInit(&outputs[i].text);
+
+        dispatchJobs();
+        if (!captureJob(job, &outputs[i], !isJobDetected(job), false))
+        {
+            // Only creating the capture file may fail, which happens with the first job
+            assert(i == 0);
+            ffStrbufDestroy(&outputs[i].text);
+            free(outputs);
+            return false;
+        }
+        putOutputs(outputs, i + 1, i);
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (!outputs[i].pending)
+            continue;
+
+        dispatchJobs();
+        bool detected = waitForJob(FF_LIST_GET(FFEngineJob, jobs, first + i));
+
+        // Fill in the following jobs detected meanwhile too, so that rows are redrawn once
+        for (uint32_t j = i; j < count; ++j)
+        {
+            FFEngineJob* job = FF_LIST_GET(FFEngineJob, jobs, first + j);
+            if (outputs[j].pending && (j == i || isJobDetected(job)))
+            {
+                captureJob(job, &outputs[j], false, !detected && j == i);
+                dispatchJobs();
+            }
+        }
+
+        uint32_t bottom = instance.state.keysHeight;
+        if (bottom > outputs[i].row)
+            printf("\e[%uA", bottom - outputs[i].row);
+        instance.state.keysHeight = outputs[i].row;
+        putOutputs(outputs, count, i);
+
+        // Clear the rows that are not used anymore
+        if (instance.state.keysHeight < bottom)
+        {
+            for (uint32_t row = instance.state.keysHeight; row < bottom; ++row)
+            {
+                if (instance.state.logoWidth > 0)
+                    printf("\e[%uC", instance.state.logoWidth);
+                fputs("\e[K\n", stdout);
+            }
+            printf("\e[%uA", bottom - instance.state.keysHeight);
+        }
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+        ffStrbufDestroy(&outputs[i].text);
+    free(outputs);
+    return true;
+}
+#endif
+
+void ffEngineRun(yyjson_mut_doc* jsonDoc)
+{
+    #ifdef FF_HAVE_THREADS
+    bool progressive = instance.config.display.progressive && !jsonDoc && !instance.config.display.pipe &&
+        instance.config.logo.position != FF_LOGO_POSITION_RIGHT;
+    #endif
+
+    for (uint32_t i = 0; i < jobs.length; ++i)
+    {
+        FFEngineJob* job = FF_LIST_GET(FFEngineJob, jobs, i);
+
+        #ifdef FF_HAVE_THREADS
+        if (engine.running)
+        {
+            dispatchJobs();
+            if (progressive && !isJobDetected(job) && printProgressively(i))
+                break;
+            if (!waitForJob(job))
+            {
+                abandonJob(job, jsonDoc);
+                continue;
+            }
+        }
+        else
+        #endif
+        if (!job->dispatched)
+            dispatchJob(job);
+
+        printJob(job, jsonDoc);
+    }
+
+    #ifdef FF_HAVE_THREADS
+    if (engine.running)
+    {
+        engine.running = false;
+        ffStdioUnlock();
+    }
+    // Abandoned detections may still use the jobs, which are leaked on purpose
+    if (engine.abandoned)
+        return;
+    #endif
+
+    ffListDestroy(&jobs);
+}
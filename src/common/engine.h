@@ -0,0 +1,17 @@
+#pragma once
+
+#include "fastfetch.h"
+
+// Queues a module to be printed. Modules are printed in the order they are added.
+// `baseInfo` may be NULL for unknown modules, whose `name` is printed as an error.
+// `module` is the JSON object of the module in the config file, if any; it's parsed right before detection starts.
+// `prepareModule` is called immediately, with the options of this occurrence
+void ffEngineAddModule(FFModuleBaseInfo* baseInfo, const char* name, yyjson_val* module);
+
+// Starts running `detectModule` of queued modules concurrently on the thread pool
+void ffEngineStart(void);
+
+// Prints queued modules, or generates their JSON results if `jsonDoc` is not NULL.
+// A module is printed, and flushed to stdout, as soon as it and all modules before it are detected.
+// Modules that are not detected before `general.deadline` or their own `timeout` are printed as timed out
+void ffEngineRun(yyjson_mut_doc* jsonDoc);
@@ -1,4 +1,5 @@
 #include "fastfetch.h"
+#include "common/engine.h"
 #include "common/parsing.h"
 #include "common/thread.h"
 #include "detection/displayserver/displayserver.h"
@@ -16,6 +17,10 @@
     #include <signal.h>
 #endif
 
+#ifdef FF_HAVE_THREADS
+    #define FF_START_DETECTION_THREADS
+#endif
+
 FFinstance instance; // Global singleton
 
 static void initState(FFstate* state)
@@ -93,6 +98,14 @@ static void chldSignalHandler(FF_MAYBE_UNUSED int signal)
 }
 #endif
 
+#ifdef FF_START_DETECTION_THREADS
+static void startDetectionThreads(void)
+{
+    // Detections of queued modules run while the logo is being printed
+    ffEngineStart();
+}
+#endif
+
 void ffStart(void)
 {
     #ifdef FF_START_DETECTION_THREADS
@@ -162,6 +175,12 @@ static void destroyState(void)
 
 void ffDestroyInstance(void)
 {
+    #ifdef FF_HAVE_THREADS
+    // Detections that timed out may still be using the instance
+    if (ffThreadPoolHasAbandonedTasks())
+        return;
+    #endif
+
     destroyConfig();
     destroyState();
 }
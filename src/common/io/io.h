@@ -86,6 +86,17 @@ static inline bool ffReadFileBufferRelative(FFNativeFD dfd, const char* fileName
     return ffAppendFileBufferRelative(dfd, fileName, buffer);
 }
 
+typedef struct FFReadFileBatchItem
+{
+    FFNativeFD dfd; // `AT_FDCWD` for the current directory on Unix
+    const char* fileName;
+    FFstrbuf* buffer;
+    bool success; // Set by `ffReadFileBatch`
+} FFReadFileBatchItem;
+
+// Same as calling `ffReadFileBufferRelative` for each item. Meant for the many tiny files of sysfs and procfs, which are read with fewer syscalls
+void ffReadFileBatch(FFReadFileBatchItem* items, uint32_t count);
+
 //Bit flags, combine with |
 typedef enum __attribute__((__packed__)) FFPathType
 {
@@ -144,9 +155,30 @@ bool ffPathExpandEnv(const char* in, FFstrbuf* out);
 FF_C_SCANF(3, 4)
 const char* ffGetTerminalResponse(const char* request, int nParams, const char* format, ...);
 
-// Not thread safe!
+// Redirects stdout / stderr of the whole process to the null device.
+// Holds the stdio lock while suppressed, so that output of other threads won't get lost
 bool ffSuppressIO(bool suppress);
 
+// Recursive per thread. Must be held by the thread that prints while detections run concurrently.
+// Returns false if the lock can't be acquired in `timeout` ms; 0 for no timeout
+bool ffStdioTimedLock(uint32_t timeout);
+void ffStdioUnlock(void);
+
+static inline void ffStdioLock(void)
+{
+    ffStdioTimedLock(0);
+}
+
+// Acquires the stdio lock without waiting for other threads, restoring stdout / stderr if they are suppressed.
+// Called by the printing thread when it stops waiting for detection threads. After that the lock is no longer exclusive,
+// and suppressing IO fails
+void ffStdioReclaim(void);
+
+// Redirects stdout of the whole process to a temporary file, until `ffStdioEndCapture` appends what was written to `buffer`.
+// The stdio lock must be held while capturing
+bool ffStdioBeginCapture(void);
+void ffStdioEndCapture(FFstrbuf* buffer);
+
 static inline void ffUnsuppressIO(bool* suppressed)
 {
     if (!*suppressed) return;
@@ -2,6 +2,7 @@
 #include "fastfetch.h"
 #include "util/stringUtils.h"
 #include "common/time.h"
+#include "common/thread.h"
 
 #include <fcntl.h>
 #include <termios.h>
@@ -136,6 +137,26 @@ bool ffAppendFileBufferRelative(int dfd, const char* fileName, FFstrbuf* buffer)
     return ffAppendFDBuffer(fd, buffer);
 }
 
+void ffReadFileBatch(FFReadFileBatchItem* items, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        FFReadFileBatchItem* item = &items[i];
+        FFstrbuf* buffer = item->buffer;
+        ffStrbufClear(buffer);
+        item->success = false;
+
+        int FF_AUTO_CLOSE_FD fd = openat(item->dfd, item->fileName, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) continue;
+
+        // Most sysfs and procfs files fit in one page, and their sizes reported by `fstat` are meaningless, so don't bother
+        ffStrbufEnsureFree(buffer, 4095);
+        readUntilEOF(fd, buffer);
+        buffer->chars[buffer->length] = '\0';
+        item->success = buffer->length > 0;
+    }
+}
+
 bool ffPathExpandEnv(FF_MAYBE_UNUSED const char* in, FF_MAYBE_UNUSED FFstrbuf* out)
 {
     bool result = false;
@@ -254,6 +275,126 @@ const char* ffGetTerminalResponse(const char* request, int nParams, const char*
     return NULL;
 }
 
+static struct
+{
+    FFThreadMutex mutex;
+    #ifdef FF_HAVE_THREADS
+    FFThreadCond released;
+    #endif
+    bool locked;
+    bool reclaimed;
+
+    bool init;
+    int origOut;
+    int origErr;
+    int nullFile;
+    int captureFile;
+    bool capturing;
+    uint32_t suppressDepth;
+} stdio = {
+    .mutex = FF_THREAD_MUTEX_INITIALIZER,
+    #ifdef FF_HAVE_THREADS
+    .released = FF_THREAD_COND_INITIALIZER,
+    #endif
+    .origOut = -1,
+    .origErr = -1,
+    .nullFile = -1,
+    .captureFile = -1,
+};
+
+#ifdef FF_HAVE_THREADS
+static _Thread_local uint32_t stdioLockDepth;
+static _Thread_local bool stdioLockOwned;
+#endif
+
+bool ffStdioTimedLock(FF_MAYBE_UNUSED uint32_t timeout)
+{
+    #ifdef FF_HAVE_THREADS
+    if (stdioLockDepth > 0)
+    {
+        ++stdioLockDepth;
+        return true;
+    }
+
+    double deadline = ffTimeGetTick() + timeout;
+    ffThreadMutexLock(&stdio.mutex);
+    while (stdio.locked && !stdio.reclaimed)
+    {
+        if (timeout == 0)
+            ffThreadCondWait(&stdio.released, &stdio.mutex);
+        else
+        {
+            double now = ffTimeGetTick();
+            if (now >= deadline || !ffThreadCondTimedWait(&stdio.released, &stdio.mutex, (uint32_t) (deadline - now) + 1))
+                break;
+        }
+    }
+    bool acquired = !stdio.locked || stdio.reclaimed;
+    if (acquired)
+    {
+        ++stdioLockDepth;
+        // The lock is not exclusive anymore after being reclaimed
+        if (!stdio.reclaimed)
+        {
+            stdio.locked = true;
+            stdioLockOwned = true;
+        }
+    }
+    ffThreadMutexUnlock(&stdio.mutex);
+    return acquired;
+    #else
+    return true;
+    #endif
+}
+
+void ffStdioUnlock(void)
+{
+    #ifdef FF_HAVE_THREADS
+    assert(stdioLockDepth > 0);
+    if (--stdioLockDepth == 0 && stdioLockOwned)
+    {
+        ffThreadMutexLock(&stdio.mutex);
+        stdio.locked = false;
+        stdioLockOwned = false;
+        ffThreadCondSignal(&stdio.released);
+        ffThreadMutexUnlock(&stdio.mutex);
+    }
+    #endif
+}
+
+static void initStdio(void)
+{
+    if (stdio.init)
+        return;
+
+    stdio.init = true;
+    stdio.origOut = dup(STDOUT_FILENO);
+    stdio.origErr = dup(STDERR_FILENO);
+    stdio.nullFile = open("/dev/null", O_WRONLY | O_CLOEXEC);
+}
+
+static void redirectStdio(bool suppress)
+{
+    fflush(stdout);
+    fflush(stderr);
+
+    dup2(suppress ? stdio.nullFile : stdio.capturing ? stdio.captureFile : stdio.origOut, STDOUT_FILENO);
+    dup2(suppress ? stdio.nullFile : stdio.origErr, STDERR_FILENO);
+}
+
+void ffStdioReclaim(void)
+{
+    #ifdef FF_HAVE_THREADS
+    ffThreadMutexLock(&stdio.mutex);
+    stdio.reclaimed = true;
+    if (stdio.suppressDepth > 0)
+        redirectStdio(false);
+    ffThreadCondBroadcast(&stdio.released);
+    ffThreadMutexUnlock(&stdio.mutex);
+    ++stdioLockDepth;
+    #endif
+}
+
 bool ffSuppressIO(bool suppress)
 {
     #ifndef NDEBUG
@@ -261,31 +402,64 @@ bool ffSuppressIO(bool suppress)
         return false;
     #endif
 
-    static bool init = false;
-    static int origOut = -1;
-    static int origErr = -1;
-    static int nullFile = -1;
+    if (suppress)
+        ffStdioLock();
+
+    ffThreadMutexLock(&stdio.mutex);
+
+    if (suppress)
+        initStdio();
 
-    if(!init)
+    // Output of the printing thread must not be lost after it reclaimed stdio
+    bool result = stdio.nullFile != -1 && (!stdio.reclaimed || !suppress);
+
+    // Only the outermost call of the lock owner redirects
+    if (result && (suppress ? stdio.suppressDepth++ == 0 : stdio.suppressDepth > 0 && --stdio.suppressDepth == 0) && !stdio.reclaimed)
+        redirectStdio(suppress);
+
+    ffThreadMutexUnlock(&stdio.mutex);
+
+    if (!suppress || !result)
+        ffStdioUnlock();
+    return result;
+}
+
+bool ffStdioBeginCapture(void)
+{
+    fflush(stdout);
+    ffThreadMutexLock(&stdio.mutex);
+
+    initStdio();
+    if (stdio.captureFile == -1)
     {
-        if(!suppress)
-            return true;
+        FILE* file = tmpfile();
+        if (file)
+            stdio.captureFile = fileno(file);
+    }
 
-        origOut = dup(STDOUT_FILENO);
-        origErr = dup(STDERR_FILENO);
-        nullFile = open("/dev/null", O_WRONLY | O_CLOEXEC);
-        init = true;
+    bool result = stdio.origOut != -1 && stdio.captureFile != -1;
+    if (result)
+    {
+        stdio.capturing = true;
+        dup2(stdio.captureFile, STDOUT_FILENO);
     }
 
-    if(nullFile == -1)
-        return false;
+    ffThreadMutexUnlock(&stdio.mutex);
+    return result;
+}
 
+void ffStdioEndCapture(FFstrbuf* buffer)
+{
     fflush(stdout);
-    fflush(stderr);
-
-    dup2(suppress ? nullFile : origOut, STDOUT_FILENO);
-    dup2(suppress ? nullFile : origErr, STDERR_FILENO);
-    return true;
+    ffThreadMutexLock(&stdio.mutex);
+    stdio.capturing = false;
+    dup2(stdio.origOut, STDOUT_FILENO);
+    ffThreadMutexUnlock(&stdio.mutex);
+
+    lseek(stdio.captureFile, 0, SEEK_SET);
+    ffAppendFDBuffer(stdio.captureFile, buffer);
+    if (ftruncate(stdio.captureFile, 0) == 0)
+        lseek(stdio.captureFile, 0, SEEK_SET);
 }
 
 void listFilesRecursively(uint32_t baseLength, FFstrbuf* folder, uint8_t indentation, const char* folderName, bool pretty)
@@ -1,6 +1,8 @@
 #include "io.h"
 #include "fastfetch.h"
 #include "util/stringUtils.h"
+#include "common/thread.h"
+#include "common/time.h"
 
 #include <windows.h>
 #include <ntstatus.h>
@@ -145,6 +147,12 @@ ssize_t ffReadFileDataRelative(HANDLE dfd, const char* fileName, size_t dataSize
     return ffReadFDData(fd, dataSize, data);
 }
 
+void ffReadFileBatch(FFReadFileBatchItem* items, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+        items[i].success = ffReadFileBufferRelative(items[i].dfd, items[i].fileName, items[i].buffer);
+}
+
 bool ffPathExpandEnv(const char* in, FFstrbuf* out)
 {
     DWORD length = ExpandEnvironmentStringsA(in, NULL, 0);
@@ -157,6 +165,139 @@ bool ffPathExpandEnv(const char* in, FFstrbuf* out)
     return true;
 }
 
+static struct
+{
+    FFThreadMutex mutex;
+    #ifdef FF_HAVE_THREADS
+    FFThreadCond released;
+    #endif
+    bool locked;
+    bool reclaimed;
+
+    bool init;
+    HANDLE hOrigOut;
+    HANDLE hOrigErr;
+    HANDLE hNullFile;
+    int fOrigOut;
+    int fOrigErr;
+    int fNullFile;
+    HANDLE hCaptureFile;
+    int fCaptureFile;
+    bool capturing;
+    uint32_t suppressDepth;
+} stdio = {
+    .mutex = FF_THREAD_MUTEX_INITIALIZER,
+    #ifdef FF_HAVE_THREADS
+    .released = FF_THREAD_COND_INITIALIZER,
+    #endif
+    .hOrigOut = INVALID_HANDLE_VALUE,
+    .hOrigErr = INVALID_HANDLE_VALUE,
+    .hNullFile = INVALID_HANDLE_VALUE,
+    .fOrigOut = -1,
+    .fOrigErr = -1,
+    .fNullFile = -1,
+    .hCaptureFile = INVALID_HANDLE_VALUE,
+    .fCaptureFile = -1,
+};
+
+#ifdef FF_HAVE_THREADS
+static _Thread_local uint32_t stdioLockDepth;
+static _Thread_local bool stdioLockOwned;
+#endif
+
+bool ffStdioTimedLock(FF_MAYBE_UNUSED uint32_t timeout)
+{
+    #ifdef FF_HAVE_THREADS
+    if (stdioLockDepth > 0)
+    {
+        ++stdioLockDepth;
+        return true;
+    }
+
+    double deadline = ffTimeGetTick() + timeout;
+    ffThreadMutexLock(&stdio.mutex);
+    while (stdio.locked && !stdio.reclaimed)
+    {
+        if (timeout == 0)
+            ffThreadCondWait(&stdio.released, &stdio.mutex);
+        else
+        {
+            double now = ffTimeGetTick();
+            if (now >= deadline || !ffThreadCondTimedWait(&stdio.released, &stdio.mutex, (uint32_t) (deadline - now) + 1))
+                break;
+        }
+    }
+    bool acquired = !stdio.locked || stdio.reclaimed;
+    if (acquired)
+    {
+        ++stdioLockDepth;
+        // The lock is not exclusive anymore after being reclaimed
+        if (!stdio.reclaimed)
+        {
+            stdio.locked = true;
+            stdioLockOwned = true;
+        }
+    }
+    ffThreadMutexUnlock(&stdio.mutex);
+    return acquired;
+    #else
+    return true;
+    #endif
+}
+
+void ffStdioUnlock(void)
+{
+    #ifdef FF_HAVE_THREADS
+    assert(stdioLockDepth > 0);
+    if (--stdioLockDepth == 0 && stdioLockOwned)
+    {
+        ffThreadMutexLock(&stdio.mutex);
+        stdio.locked = false;
+        stdioLockOwned = false;
+        ffThreadCondSignal(&stdio.released);
+        ffThreadMutexUnlock(&stdio.mutex);
+    }
+    #endif
+}
+
+static void initStdio(void)
+{
+    if (stdio.init)
+        return;
+
+    stdio.init = true;
+    stdio.hOrigOut = GetStdHandle(STD_OUTPUT_HANDLE);
+    stdio.hOrigErr = GetStdHandle(STD_ERROR_HANDLE);
+    stdio.hNullFile = CreateFileW(L"NUL", GENERIC_READ | GENERIC_WRITE, FILE_SHARE_WRITE, 0, OPEN_EXISTING, 0, NULL);
+    stdio.fOrigOut = _dup(STDOUT_FILENO);
+    stdio.fOrigErr = _dup(STDERR_FILENO);
+    stdio.fNullFile = _open_osfhandle((intptr_t) stdio.hNullFile, 0);
+}
+
+static void redirectStdio(bool suppress)
+{
+    fflush(stdout);
+    fflush(stderr);
+
+    SetStdHandle(STD_OUTPUT_HANDLE, suppress ? stdio.hNullFile : stdio.capturing ? stdio.hCaptureFile : stdio.hOrigOut);
+    SetStdHandle(STD_ERROR_HANDLE, suppress ? stdio.hNullFile : stdio.hOrigErr);
+    _dup2(suppress ? stdio.fNullFile : stdio.capturing ? stdio.fCaptureFile : stdio.fOrigOut, STDOUT_FILENO);
+    _dup2(suppress ? stdio.fNullFile : stdio.fOrigErr, STDERR_FILENO);
+}
+
+void ffStdioReclaim(void)
+{
+    #ifdef FF_HAVE_THREADS
+    ffThreadMutexLock(&stdio.mutex);
+    stdio.reclaimed = true;
+    if (stdio.suppressDepth > 0)
+        redirectStdio(false);
+    ffThreadCondBroadcast(&stdio.released);
+    ffThreadMutexUnlock(&stdio.mutex);
+    ++stdioLockDepth;
+    #endif
+}
+
 bool ffSuppressIO(bool suppress)
 {
     #ifndef NDEBUG
@@ -164,40 +305,69 @@ bool ffSuppressIO(bool suppress)
         return false;
     #endif
 
-    static bool init = false;
-    static HANDLE hOrigOut = INVALID_HANDLE_VALUE;
-    static HANDLE hOrigErr = INVALID_HANDLE_VALUE;
-    static HANDLE hNullFile = INVALID_HANDLE_VALUE;
-    static int fOrigOut = -1;
-    static int fOrigErr = -1;
-    static int fNullFile = -1;
+    if (suppress)
+        ffStdioLock();
 
-    if (!init)
-    {
-        if(!suppress)
-            return true;
+    ffThreadMutexLock(&stdio.mutex);
 
-        hOrigOut = GetStdHandle(STD_OUTPUT_HANDLE);
-        hOrigErr = GetStdHandle(STD_ERROR_HANDLE);
-        hNullFile = CreateFileW(L"NUL", GENERIC_READ | GENERIC_WRITE, FILE_SHARE_WRITE, 0, OPEN_EXISTING, 0, NULL);
-        fOrigOut = _dup(STDOUT_FILENO);
-        fOrigErr = _dup(STDERR_FILENO);
-        fNullFile = _open_osfhandle((intptr_t) hNullFile, 0);
+    if (suppress)
+        initStdio();
 
-        init = true;
-    }
-    if (hNullFile == INVALID_HANDLE_VALUE || fNullFile == -1)
-        return false;
+    // Output of the printing thread must not be lost after it reclaimed stdio
+    bool result = stdio.hNullFile != INVALID_HANDLE_VALUE && stdio.fNullFile != -1 && (!stdio.reclaimed || !suppress);
+
+    // Only the outermost call of the lock owner redirects
+    if (result && (suppress ? stdio.suppressDepth++ == 0 : stdio.suppressDepth > 0 && --stdio.suppressDepth == 0) && !stdio.reclaimed)
+        redirectStdio(suppress);
+
+    ffThreadMutexUnlock(&stdio.mutex);
 
+    if (!suppress || !result)
+        ffStdioUnlock();
+    return result;
+}
+
+bool ffStdioBeginCapture(void)
+{
     fflush(stdout);
-    fflush(stderr);
+    ffThreadMutexLock(&stdio.mutex);
+
+    initStdio();
+    if (stdio.fCaptureFile == -1)
+    {
+        FILE* file = tmpfile();
+        if (file)
+        {
+            stdio.fCaptureFile = _fileno(file);
+            stdio.hCaptureFile = (HANDLE) _get_osfhandle(stdio.fCaptureFile);
+        }
+    }
 
-    SetStdHandle(STD_OUTPUT_HANDLE, suppress ? hNullFile : hOrigOut);
-    SetStdHandle(STD_ERROR_HANDLE, suppress ? hNullFile : hOrigErr);
-    _dup2(suppress ? fNullFile : fOrigOut, STDOUT_FILENO);
-    _dup2(suppress ? fNullFile : fOrigErr, STDERR_FILENO);
+    bool result = stdio.fOrigOut != -1 && stdio.fCaptureFile != -1;
+    if (result)
+    {
+        stdio.capturing = true;
+        SetStdHandle(STD_OUTPUT_HANDLE, stdio.hCaptureFile);
+        _dup2(stdio.fCaptureFile, STDOUT_FILENO);
+    }
 
-    return true;
+    ffThreadMutexUnlock(&stdio.mutex);
+    return result;
+}
+
+void ffStdioEndCapture(FFstrbuf* buffer)
+{
+    fflush(stdout);
+    ffThreadMutexLock(&stdio.mutex);
+    stdio.capturing = false;
+    SetStdHandle(STD_OUTPUT_HANDLE, stdio.hOrigOut);
+    _dup2(stdio.fOrigOut, STDOUT_FILENO);
+    ffThreadMutexUnlock(&stdio.mutex);
+
+    _lseek(stdio.fCaptureFile, 0, SEEK_SET);
+    ffAppendFDBuffer(stdio.hCaptureFile, buffer);
+    _chsize(stdio.fCaptureFile, 0);
+    _lseek(stdio.fCaptureFile, 0, SEEK_SET);
 }
 
 void listFilesRecursively(uint32_t baseLength, FFstrbuf* folder, uint8_t indentation, const char* folderName, bool pretty)
@@ -1,9 +1,8 @@
 #include "fastfetch.h"
-#include "common/color.h"
+#include "common/engine.h"
 #include "common/jsonconfig.h"
 #include "common/printing.h"
 #include "common/io/io.h"
-#include "common/time.h"
 #include "modules/modules.h"
 #include "util/stringUtils.h"
 
@@ -43,6 +42,11 @@ bool ffJsonConfigParseModuleArgs(const char* key, yyjson_val* val, FFModuleArgs*
         ffStrbufSetS(&moduleArgs->keyIcon, yyjson_get_str(val));
         return true;
     }
+    else if(ffStrEqualsIgnCase(key, "timeout"))
+    {
+        // Handled by the engine
+        return true;
+    }
     return false;
 }
 
@@ -95,82 +99,19 @@ const char* ffJsonConfigParseEnum(yyjson_val* val, int* result, FFKeyValuePair p
         return "Invalid enum value type; must be a string or integer";
 }
 
-static inline void genJsonResult(FFModuleBaseInfo* baseInfo, yyjson_mut_doc* doc)
+static FFModuleBaseInfo* findModuleInfo(const char* type)
 {
-    yyjson_mut_val* module = yyjson_mut_arr_add_obj(doc, doc->root);
-    yyjson_mut_obj_add_str(doc, module, "type", baseInfo->name);
-    if (baseInfo->generateJsonResult)
-        baseInfo->generateJsonResult(baseInfo, doc, module);
-    else
-        yyjson_mut_obj_add_str(doc, module, "error", "Unsupported for JSON format");
-}
-
-static bool parseModuleJsonObject(const char* type, yyjson_val* jsonVal, yyjson_mut_doc* jsonDoc)
-{
-    if(!ffCharIsEnglishAlphabet(type[0])) return false;
+    if(!ffCharIsEnglishAlphabet(type[0])) return NULL;
 
     for (FFModuleBaseInfo** modules = ffModuleInfos[toupper(type[0]) - 'A']; *modules; ++modules)
     {
-        FFModuleBaseInfo* baseInfo = *modules;
-        if (ffStrEqualsIgnCase(type, baseInfo->name))
-        {
-            if (jsonVal) baseInfo->parseJsonObject(baseInfo, jsonVal);
-            if (__builtin_expect(jsonDoc != NULL, false))
-                genJsonResult(baseInfo, jsonDoc);
-            else
-                baseInfo->printModule(baseInfo);
-            return true;
-        }
-    }
-    return false;
-}
-
-static void prepareModuleJsonObject(const char* type, yyjson_val* module)
-{
-    FFconfig* cfg = &instance.config;
-    switch (type[0])
-    {
-        case 'b': case 'B': {
-            if (ffStrEqualsIgnCase(type, FF_CPUUSAGE_MODULE_NAME))
-                ffPrepareCPUUsage();
-            break;
-        }
-        case 'd': case 'D': {
-            if (ffStrEqualsIgnCase(type, FF_DISKIO_MODULE_NAME))
-            {
-                if (module) cfg->modules.diskIo.moduleInfo.parseJsonObject(&cfg->modules.diskIo, module);
-                ffPrepareDiskIO(&cfg->modules.diskIo);
-            }
-            break;
-        }
-        case 'n': case 'N': {
-            if (ffStrEqualsIgnCase(type, FF_NETIO_MODULE_NAME))
-            {
-                if (module) cfg->modules.netIo.moduleInfo.parseJsonObject(&cfg->modules.netIo, module);
-                ffPrepareNetIO(&cfg->modules.netIo);
-            }
-            break;
-        }
-        case 'p': case 'P': {
-            if (ffStrEqualsIgnCase(type, FF_PUBLICIP_MODULE_NAME))
-            {
-                if (module) cfg->modules.publicIP.moduleInfo.parseJsonObject(&cfg->modules.publicIP, module);
-                ffPreparePublicIp(&cfg->modules.publicIP);
-            }
-            break;
-        }
-        case 'w': case 'W': {
-            if (ffStrEqualsIgnCase(type, FF_WEATHER_MODULE_NAME))
-            {
-                if (module) cfg->modules.weather.moduleInfo.parseJsonObject(&cfg->modules.weather, module);
-                ffPrepareWeather(&cfg->modules.weather);
-            }
-            break;
-        }
+        if (ffStrEqualsIgnCase(type, (*modules)->name))
+            return *modules;
     }
+    return NULL;
 }
 
-static const char* printJsonConfig(bool prepare, yyjson_mut_doc* jsonDoc)
+static const char* prepareJsonConfig(void)
 {
     yyjson_val* const root = yyjson_doc_get_root(instance.state.configDoc);
     assert(root);
@@ -182,15 +123,10 @@ static const char* printJsonConfig(bool prepare, yyjson_mut_doc* jsonDoc)
     if (!modules) return NULL;
     if (!yyjson_is_arr(modules)) return "Property 'modules' must be an array of strings or objects";
 
-    int32_t thres = instance.config.display.stat;
     yyjson_val* item;
     size_t idx, max;
     yyjson_arr_foreach(modules, idx, max, item)
     {
-        double ms = 0;
-        if(!prepare && thres >= 0)
-            ms = ffTimeGetTick();
-
         yyjson_val* module = item;
         const char* type = yyjson_get_str(module);
         if (type)
@@ -205,32 +141,11 @@ static const char* printJsonConfig(bool prepare, yyjson_mut_doc* jsonDoc)
         else
             return "modules must be an array of strings or objects";
 
-        if(prepare)
-            prepareModuleJsonObject(type, module);
-        else if(!parseModuleJsonObject(type, module, jsonDoc))
+        FFModuleBaseInfo* baseInfo = findModuleInfo(type);
+        if (!baseInfo)
             return "Unknown module type";
 
-        if(!prepare && thres >= 0)
-        {
-            ms = ffTimeGetTick() - ms;
-            if (jsonDoc)
-            {
-                yyjson_mut_val* moduleJson = yyjson_mut_arr_get_last(jsonDoc->root);
-                yyjson_mut_obj_add_real(jsonDoc, moduleJson, "stat", ms);
-            }
-            else
-            {
-                char str[64];
-                int len = snprintf(str, sizeof str, "%.3fms", ms);
-                if (thres > 0)
-                    snprintf(str, sizeof str, "\e[%sm%.3fms\e[m", (ms <= thres ? FF_COLOR_FG_GREEN : ms <= 2 * thres ? FF_COLOR_FG_YELLOW : FF_COLOR_FG_RED), ms);
-                printf("\e[s\e[1A\e[9999999C\e[%dD%s\e[u", len, str); // Save; Up 1; Right 9999999; Left <len>; Print <str>; Load
-            }
-        }
-
-        #if defined(_WIN32)
-        if (!instance.config.display.noBuffer && !jsonDoc) fflush(stdout);
-        #endif
+        ffEngineAddModule(baseInfo, type, module);
     }
 
     return NULL;
@@ -238,7 +153,17 @@ static const char* printJsonConfig(bool prepare, yyjson_mut_doc* jsonDoc)
 
 void ffPrintJsonConfig(bool prepare, yyjson_mut_doc* jsonDoc)
 {
-    const char* error = printJsonConfig(prepare, jsonDoc);
+    // Modules before the invalid one are still printed
+    static const char* error;
+
+    if (prepare)
+    {
+        error = prepareJsonConfig();
+        return;
+    }
+
+    ffEngineRun(jsonDoc);
+
     if (error)
     {
         if (jsonDoc)
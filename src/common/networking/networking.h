@@ -14,13 +14,15 @@ typedef struct FFNetworkingState {
         uintptr_t sockfd;
         OVERLAPPED overlapped;
     #else
-        int sockfd;
-        FFstrbuf command;
+        int sockfd; // The socket the request is sent on, -1 once the request has finished or failed
+        int racingFd; // A parallel connection attempt to the next address, -1 if none
+        FFstrbuf command; // The request, empty once sent
+        uint32_t commandSent; // Bytes of `command` sent
         struct addrinfo* addr;
-
-        #ifdef FF_HAVE_THREADS
-            FFThreadType thread;
-        #endif
+        struct addrinfo* nextAddr; // The next address to connect to if the current attempts fail or take too long
+        double nextAttempt; // Tick when `nextAddr` is raced
+        bool connected;
+        const char* error; // Set once the request has failed
     #endif
 
     uint32_t timeout;
@@ -32,6 +34,13 @@ typedef struct FFNetworkingState {
 const char* ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* host, const char* path, const char* headers);
 const char* ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buffer);
 
+// Checks the status line of a response received by `ffNetworkingRecvHttpResponse`
+static inline bool ffNetworkingIsHttpOk(const FFstrbuf* response)
+{
+    // HTTP/1.1 200 OK
+    return ffStrbufStartsWithS(response, "HTTP/1.") && response->length >= 12 && memcmp(response->chars + 8, " 200", 4) == 0;
+}
+
 #ifdef FF_HAVE_ZLIB
 const char* ffNetworkingLoadZlibLibrary(void);
 bool ffNetworkingDecompressGzip(FFstrbuf* buffer, char* headerEnd);
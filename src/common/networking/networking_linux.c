@@ -2,6 +2,7 @@
 #include "common/networking/networking.h"
 #include "common/time.h"
 #include "common/library.h"
+#include "util/FFlist.h"
 #include "util/stringUtils.h"
 #include "util/mallocHelper.h"
 #include "util/debug.h"
@@ -16,175 +17,395 @@
 #include <errno.h>
 #include <fcntl.h>
 
-static const char* tryNonThreadingFastPath(FFNetworkingState* state)
+// Delay before connecting to the next address of a host in parallel, as recommended by RFC 8305 (Happy Eyeballs v2)
+#define FF_NETWORKING_ATTEMPT_DELAY 250
+
+// Every request that is connecting or sending, plus the ones whose response is being received.
+// There is no networking thread: the thread waiting for a response drives all requests in flight, so that the
+// round trips overlap no matter which response is waited for first
+static struct
+{
+    FFThreadMutex mutex;
+    FFlist states; // FFNetworkingState*
+    pid_t pid; // A forked child inherits the requests of its parent, which it must not touch
+} loop = { .mutex = FF_THREAD_MUTEX_INITIALIZER };
+
+static void closeSocket(int* fd)
+{
+    if (*fd >= 0)
+    {
+        close(*fd);
+        *fd = -1;
+    }
+}
+
+static void releaseState(FFNetworkingState* state)
+{
+    if (state->addr)
+    {
+        freeaddrinfo(state->addr);
+        state->addr = NULL;
+    }
+    state->nextAddr = NULL;
+    closeSocket(&state->racingFd);
+    ffStrbufDestroy(&state->command);
+}
+
+static void failState(FFNetworkingState* state, const char* error)
+{
+    FF_DEBUG("Request failed: %s", error);
+    state->error = error;
+    closeSocket(&state->sockfd);
+    releaseState(state);
+}
+
+static int createSocket(const struct addrinfo* addr)
+{
+    int fd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+    if (fd == -1)
+    {
+        FF_DEBUG("socket() failed: %s (errno=%d)", strerror(errno), errno);
+        return -1;
+    }
+
+    if (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == -1)
+    {
+        FF_DEBUG("fcntl(F_SETFL) failed: %s", strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    #ifdef FD_CLOEXEC
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    #endif
+
+    int flag = 1;
+    #ifdef TCP_NODELAY
+    // Disable Nagle's algorithm to reduce small packet transmission delay
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    #endif
+
+    #ifdef TCP_QUICKACK
+    // Set TCP_QUICKACK option to avoid delayed acknowledgments
+    setsockopt(fd, IPPROTO_TCP, TCP_QUICKACK, &flag, sizeof(flag));
+    #endif
+
+    // Set larger initial receive buffer instead of small repeated receives
+    int rcvbuf = 65536; // 64KB
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    return fd;
+}
+
+// Starts a non-blocking connection to `addr`. Returns -1 if it fails immediately
+static int startConnecting(const struct addrinfo* addr)
+{
+    int fd = createSocket(addr);
+    if (fd == -1)
+        return -1;
+
+    FF_DEBUG("Connecting to address family %d: fd=%d", addr->ai_family, fd);
+    if (connect(fd, addr->ai_addr, addr->ai_addrlen) == 0 || errno == EINPROGRESS)
+        return fd;
+
+    FF_DEBUG("connect() failed: %s (errno=%d)", strerror(errno), errno);
+    close(fd);
+    return -1;
+}
+
+// Connects with TCP Fast Open, sending the beginning of the request in the SYN packet if the server allows it.
+// Returns -1 if TFO is not available
+static int startConnectingTfo(FFNetworkingState* state)
 {
     #if defined(TCP_FASTOPEN) || __APPLE__
 
+        #ifdef __linux__
+        // Linux doesn't support sendto() on unconnected sockets
         if (!state->tfo)
         {
-            #ifdef __linux__
-            // Linux doesn't support sendto() on unconnected sockets
             FF_DEBUG("TCP Fast Open disabled, skipping");
-            return "TCP Fast Open disabled";
-            #endif
+            return -1;
         }
-        else
+        #endif
+
+        int fd = createSocket(state->nextAddr);
+        if (fd == -1)
+            return -1;
+
+        #ifndef __APPLE__ // On macOS, TCP_FASTOPEN doesn't seem to be needed
+        // Set TCP Fast Open
+        #ifdef __linux__
+        int flag = 5; // the queue length of pending packets
+        #else
+        int flag = 1; // enable TCP Fast Open
+        #endif
+        if (setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN, &flag, sizeof(flag)) != 0)
         {
-            FF_DEBUG("Attempting to use TCP Fast Open to connect");
-
-            #ifndef __APPLE__ // On macOS, TCP_FASTOPEN doesn't seem to be needed
-            // Set TCP Fast Open
-            #ifdef __linux__
-            int flag = 5; // the queue length of pending packets
-            #else
-            int flag = 1; // enable TCP Fast Open
-            #endif
-            if (setsockopt(state->sockfd, IPPROTO_TCP,
-                #ifdef __APPLE__
-                // https://github.com/rust-lang/libc/pull/3135
-                0x218 // TCP_FASTOPEN_FORCE_ENABLE
-                #else
-                TCP_FASTOPEN
-                #endif
-                , &flag, sizeof(flag)) != 0) {
-                FF_DEBUG("Failed to set TCP_FASTOPEN option: %s", strerror(errno));
-                return "setsockopt(TCP_FASTOPEN) failed";
-            } else {
-                #ifdef __linux__
-                FF_DEBUG("Successfully set TCP_FASTOPEN option, queue length: %d", flag);
-                #elif defined(__APPLE__)
-                FF_DEBUG("Successfully set TCP_FASTOPEN_FORCE_ENABLE option");
-                #else
-                FF_DEBUG("Successfully set TCP_FASTOPEN option");
-                #endif
-            }
-            #endif
+            FF_DEBUG("Failed to set TCP_FASTOPEN option: %s", strerror(errno));
+            close(fd);
+            return -1;
         }
+        #endif
 
         #ifndef __APPLE__
-        FF_DEBUG("Using sendto() + MSG_DONTWAIT to send %u bytes of data", state->command.length);
-        ssize_t sent = sendto(state->sockfd,
-                                state->command.chars,
-                                state->command.length,
+        FF_DEBUG("Using sendto() + MSG_FASTOPEN to send %u bytes of data", state->command.length);
+        ssize_t sent = sendto(fd,
+                              state->command.chars,
+                              state->command.length,
             #ifdef MSG_FASTOPEN
-                                MSG_FASTOPEN |
+                              MSG_FASTOPEN |
             #endif
             #ifdef MSG_NOSIGNAL
-                                MSG_NOSIGNAL |
+                              MSG_NOSIGNAL |
             #endif
-                                MSG_DONTWAIT,
-                                state->addr->ai_addr,
-                                state->addr->ai_addrlen);
+                              MSG_DONTWAIT,
+                              state->nextAddr->ai_addr,
+                              state->nextAddr->ai_addrlen);
         #else
-        if (fcntl(state->sockfd, F_SETFL, O_NONBLOCK) == -1) {
-            FF_DEBUG("fcntl(F_SETFL) failed: %s", strerror(errno));
-            return "fcntl(F_SETFL) failed";
-        }
         FF_DEBUG("Using connectx() to send %u bytes of data", state->command.length);
-        // Use connectx to establish connection and send data in one call
-        size_t sent;
-        if (connectx(state->sockfd,
+        size_t sentSize = 0;
+        ssize_t sent = connectx(fd,
             &(sa_endpoints_t) {
-                .sae_dstaddr = state->addr->ai_addr,
-                .sae_dstaddrlen = state->addr->ai_addrlen,
+                .sae_dstaddr = state->nextAddr->ai_addr,
+                .sae_dstaddrlen = state->nextAddr->ai_addrlen,
             },
             SAE_ASSOCID_ANY, state->tfo ? CONNECT_DATA_IDEMPOTENT : 0,
             &(struct iovec) {
                 .iov_base = state->command.chars,
                 .iov_len = state->command.length,
-            }, 1, &sent, NULL) != 0) sent = 0;
-        if (fcntl(state->sockfd, F_SETFL, 0) == -1) {
-            FF_DEBUG("fcntl(F_SETFL) failed: %s", strerror(errno));
-            return "fcntl(F_SETFL) failed";
+            }, 1, &sentSize, NULL) == 0 || errno == EINPROGRESS ? (ssize_t) sentSize : -1;
+        if (sent == 0)
+        {
+            sent = -1;
+            errno = EINPROGRESS;
         }
         #endif
-        if (sent > 0 || (errno == EAGAIN || errno == EWOULDBLOCK
-            #ifdef __APPLE__
-            // On macOS EINPROGRESS means the connection cannot be completed immediately
-            // On Linux, it means the TFO cookie is not available locally
-            || errno == EINPROGRESS
-            #endif
-        ))
+
+        // Without a TFO cookie, the connection is started as usual and nothing is sent
+        if (sent > 0 || errno == EINPROGRESS)
         {
-            FF_DEBUG(
-                #ifdef __APPLE__
-                "connectx()"
-                #else
-                "sendto()"
-                #endif
-                " %s (sent=%zd, errno=%d: %s)", errno == 0 ? "succeeded" : "was in progress",
-                sent, errno, strerror(errno));
-            freeaddrinfo(state->addr);
-            state->addr = NULL;
-            ffStrbufDestroy(&state->command);
-            return NULL;
+            FF_DEBUG("TFO connection in progress, %zd bytes sent with SYN", sent > 0 ? sent : 0);
+            state->commandSent = sent > 0 ? (uint32_t) sent : 0;
+            return fd;
         }
 
-        FF_DEBUG(
-            #ifdef __APPLE__
-            "connectx()"
-            #else
-            "sendto()"
-            #endif
-            " failed: %s (errno=%d)", strerror(errno), errno);
-        #ifdef __APPLE__
-        return "connectx() failed";
-        #else
-        return "sendto() failed";
-        #endif
+        FF_DEBUG("TFO failed: %s (errno=%d)", strerror(errno), errno);
+        close(fd);
+        return -1;
+
     #else
         FF_UNUSED(state);
-        return "TFO support is not available";
+        return -1;
     #endif
 }
 
-// Traditional connect and send function
-static const char* connectAndSend(FFNetworkingState* state)
+// Starts connecting to the next address that doesn't fail immediately. Returns -1 if there is none
+static int connectNextAddr(FFNetworkingState* state)
 {
-    const char* ret = NULL;
-    FF_DEBUG("Using traditional connection method to connect");
-
-    FF_DEBUG("Attempting connect() to server...");
-    if(connect(state->sockfd, state->addr->ai_addr, state->addr->ai_addrlen) == -1)
+    while (state->nextAddr)
     {
-        FF_DEBUG("connect() failed: %s (errno=%d)", strerror(errno), errno);
-        ret = "connect() failed";
-        goto error;
+        const struct addrinfo* addr = state->nextAddr;
+        state->nextAddr = addr->ai_next;
+        int fd = startConnecting(addr);
+        if (fd >= 0)
+        {
+            state->nextAttempt = ffTimeGetTick() + FF_NETWORKING_ATTEMPT_DELAY;
+            return fd;
+        }
     }
-    FF_DEBUG("connect() succeeded");
+    return -1;
+}
+
+// Returns 1 if connected, 0 if still connecting, -1 if the connection failed
+static int getConnectionStatus(int fd)
+{
+    struct sockaddr_storage addr;
+    socklen_t addrLen = sizeof(addr);
+    if (getpeername(fd, (struct sockaddr*) &addr, &addrLen) == 0)
+        return 1;
+
+    int error = 0;
+    socklen_t len = sizeof(error);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &len) != 0)
+        error = errno;
+    if (error == 0)
+        return 0;
+
+    FF_DEBUG("Connection failed: fd=%d, %s (errno=%d)", fd, strerror(error), error);
+    return -1;
+}
+
+// Handles an event of a connection attempt: the primary one if `fd` is `&state->sockfd`, or the racing one
+static void handleConnectEvent(FFNetworkingState* state, int* fd)
+{
+    int status = getConnectionStatus(*fd);
+    if (status == 0)
+        return;
 
-    FF_DEBUG("Attempting to send %u bytes of data...", state->command.length);
-    if(send(state->sockfd, state->command.chars, state->command.length, 0) < 0)
+    if (status < 0)
     {
-        FF_DEBUG("send() failed: %s (errno=%d)", strerror(errno), errno);
-        ret = "send() failed";
-        goto error;
+        closeSocket(fd);
+        if (fd == &state->sockfd)
+        {
+            // Continue with the racing attempt, which hasn't sent anything yet
+            state->sockfd = state->racingFd;
+            state->racingFd = -1;
+            state->commandSent = 0;
+            if (state->sockfd == -1)
+                state->sockfd = connectNextAddr(state);
+        }
+        else
+            state->racingFd = connectNextAddr(state);
+
+        if (state->sockfd == -1 && state->racingFd == -1)
+            failState(state, "connect() failed");
+        return;
     }
-    FF_DEBUG("Data sent successfully");
 
-    goto exit;
+    FF_DEBUG("Connection established: fd=%d", *fd);
+    if (fd == &state->racingFd)
+    {
+        closeSocket(&state->sockfd);
+        state->sockfd = state->racingFd;
+        state->racingFd = -1;
+        state->commandSent = 0;
+    }
+    else
+        closeSocket(&state->racingFd);
+    state->connected = true;
+}
 
-error:
-    FF_DEBUG("Error occurred, closing socket");
-    close(state->sockfd);
-    state->sockfd = -1;
+static void handleSendEvent(FFNetworkingState* state)
+{
+    ssize_t sent = send(state->sockfd,
+                        state->command.chars + state->commandSent,
+                        state->command.length - state->commandSent,
+        #ifdef MSG_NOSIGNAL
+                        MSG_NOSIGNAL |
+        #endif
+                        MSG_DONTWAIT);
+    if (sent < 0)
+    {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            failState(state, "send() failed");
+        return;
+    }
 
-exit:
-    FF_DEBUG("Releasing address info and other resources");
-    freeaddrinfo(state->addr);
-    state->addr = NULL;
-    ffStrbufDestroy(&state->command);
+    state->commandSent += (uint32_t) sent;
+    if (state->commandSent == state->command.length)
+    {
+        FF_DEBUG("Request sent: fd=%d, %u bytes", state->sockfd, state->commandSent);
+        releaseState(state);
+    }
+}
 
-    return ret;
+static inline bool isSending(const FFNetworkingState* state)
+{
+    return state->error == NULL && state->command.length > 0;
 }
 
-FF_THREAD_ENTRY_DECL_WRAPPER(connectAndSend, FFNetworkingState*);
+// Runs the loop until the request of `owner` is sent and its response is readable, or `deadline` (0 for none) is reached.
+// `loop.mutex` must be locked
+static bool runLoop(FFNetworkingState* owner, double deadline)
+{
+    FF_LIST_AUTO_DESTROY fds = ffListCreate(sizeof(struct pollfd));
+
+    while (true)
+    {
+        ffListClear(&fds);
+        double now = ffTimeGetTick();
+        double wakeup = deadline;
+
+        if (deadline > 0 && now >= deadline)
+        {
+            failState(owner, "Request timed out");
+            return false;
+        }
+
+        FF_LIST_FOR_EACH(FFNetworkingState*, pState, loop.states)
+        {
+            FFNetworkingState* state = *pState;
+            if (!isSending(state))
+                continue;
+
+            if (!state->connected)
+            {
+                // Race the next address if the current one doesn't answer quickly enough
+                if (state->racingFd == -1 && state->nextAddr)
+                {
+                    if (now >= state->nextAttempt)
+                        state->racingFd = connectNextAddr(state);
+                    else if (wakeup == 0 || state->nextAttempt < wakeup)
+                        wakeup = state->nextAttempt;
+                }
+                if (state->racingFd >= 0)
+                    *(struct pollfd*) ffListAdd(&fds) = (struct pollfd) { .fd = state->racingFd, .events = POLLOUT };
+            }
+            *(struct pollfd*) ffListAdd(&fds) = (struct pollfd) { .fd = state->sockfd, .events = POLLOUT };
+        }
+
+        if (owner->error)
+            return false;
+        if (!isSending(owner))
+            *(struct pollfd*) ffListAdd(&fds) = (struct pollfd) { .fd = owner->sockfd, .events = POLLIN };
+
+        int timeout = -1;
+        if (wakeup > 0)
+        {
+            if (wakeup <= now)
+                timeout = 0;
+            else
+                timeout = (int) (wakeup - now) + 1;
+        }
+
+        int ready = poll((struct pollfd*) fds.data, fds.length, timeout);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            FF_DEBUG("poll() failed: %s (errno=%d)", strerror(errno), errno);
+            failState(owner, "poll() failed");
+            return false;
+        }
+
+        FF_LIST_FOR_EACH(struct pollfd, pfd, fds)
+        {
+            if (pfd->revents == 0)
+                continue;
+
+            if (pfd->events & POLLIN)
+                return true;
+
+            FF_LIST_FOR_EACH(FFNetworkingState*, pState, loop.states)
+            {
+                FFNetworkingState* state = *pState;
+                if (!isSending(state))
+                    continue;
+
+                if (!state->connected && (pfd->fd == state->sockfd || pfd->fd == state->racingFd))
+                    handleConnectEvent(state, pfd->fd == state->sockfd ? &state->sockfd : &state->racingFd);
+                else if (state->connected && pfd->fd == state->sockfd)
+                    handleSendEvent(state);
+                else
+                    continue;
+                break;
+            }
+        }
+    }
+}
 
-// Parallel DNS resolution and socket creation
 static const char* initNetworkingState(FFNetworkingState* state, const char* host, const char* path, const char* headers)
 {
     FF_DEBUG("Initializing network connection state: host=%s, path=%s", host, path);
 
+    state->sockfd = -1;
+    state->racingFd = -1;
+    state->addr = NULL;
+    state->nextAddr = NULL;
+    state->commandSent = 0;
+    state->connected = false;
+    state->error = NULL;
+
     // Initialize command and host information
     ffStrbufInitA(&state->command, 64);
     ffStrbufAppendS(&state->command, "GET ");
@@ -205,97 +426,26 @@ static const char* initNetworkingState(FFNetworkingState* state, const char* hos
     ffStrbufAppendS(&state->command, headers);
     ffStrbufAppendS(&state->command, "\r\n");
 
-    #ifdef FF_HAVE_THREADS
-    state->thread = 0;
-    FF_DEBUG("Thread ID initialized to 0");
-    #endif
-
-    const char* ret = NULL;
-
     struct addrinfo hints = {
         .ai_family = state->ipv6 ? AF_INET6 : AF_INET,
         .ai_socktype = SOCK_STREAM,
-        .ai_flags = AI_NUMERICSERV
+        // Use AI_NUMERICSERV flag to indicate the service is a numeric port, reducing parsing time
+        .ai_flags = AI_NUMERICSERV,
     };
 
     FF_DEBUG("Resolving address: %s (%s)", host, state->ipv6 ? "IPv6" : "IPv4");
-    // Use AI_NUMERICSERV flag to indicate the service is a numeric port, reducing parsing time
-
-    if(getaddrinfo(host, "80", &hints, &state->addr) != 0)
+    int gaiError = getaddrinfo(host, "80", &hints, &state->addr);
+    if (gaiError != 0)
     {
-        FF_DEBUG("getaddrinfo() failed: %s", gai_strerror(errno));
-        ret = "getaddrinfo() failed";
-        goto error;
+        FF_DEBUG("getaddrinfo() failed: %s", gai_strerror(gaiError));
+        state->addr = NULL;
+        failState(state, "getaddrinfo() failed");
+        return state->error;
     }
+    state->nextAddr = state->addr;
     FF_DEBUG("Address resolution successful");
 
-    FF_DEBUG("Creating socket");
-    state->sockfd = socket(state->addr->ai_family, state->addr->ai_socktype, state->addr->ai_protocol);
-    if(state->sockfd == -1)
-    {
-        FF_DEBUG("socket() failed: %s (errno=%d)", strerror(errno), errno);
-        ret = "socket() failed";
-        goto error;
-    }
-    FF_DEBUG("Socket creation successful: fd=%d", state->sockfd);
-
-    int flag = 1;
-    #ifdef TCP_NODELAY
-    // Disable Nagle's algorithm to reduce small packet transmission delay
-    if (setsockopt(state->sockfd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag)) != 0) {
-        FF_DEBUG("Failed to set TCP_NODELAY: %s", strerror(errno));
-    } else {
-        FF_DEBUG("Successfully disabled Nagle's algorithm");
-    }
-    #endif
-
-    #ifdef TCP_QUICKACK
-    // Set TCP_QUICKACK option to avoid delayed acknowledgments
-    if (setsockopt(state->sockfd, IPPROTO_TCP, TCP_QUICKACK, &flag, sizeof(flag)) != 0) {
-        FF_DEBUG("Failed to set TCP_QUICKACK: %s", strerror(errno));
-    } else {
-        FF_DEBUG("Successfully enabled TCP quick acknowledgment");
-    }
-    #endif
-
-    if (state->timeout > 0)
-    {
-        FF_DEBUG("Setting connection timeout: %u ms", state->timeout);
-        FF_MAYBE_UNUSED uint32_t sec = state->timeout / 1000;
-        if (sec == 0) sec = 1;
-
-        #ifdef TCP_CONNECTIONTIMEOUT
-        FF_DEBUG("Using TCP_CONNECTIONTIMEOUT: %u seconds", sec);
-        setsockopt(state->sockfd, IPPROTO_TCP, TCP_CONNECTIONTIMEOUT, &sec, sizeof(sec));
-        #elif defined(TCP_KEEPINIT)
-        FF_DEBUG("Using TCP_KEEPINIT: %u seconds", sec);
-        setsockopt(state->sockfd, IPPROTO_TCP, TCP_KEEPINIT, &sec, sizeof(sec));
-        #elif defined(TCP_USER_TIMEOUT)
-        FF_DEBUG("Using TCP_USER_TIMEOUT: %u milliseconds", state->timeout);
-        setsockopt(state->sockfd, IPPROTO_TCP, TCP_USER_TIMEOUT, &state->timeout, sizeof(state->timeout));
-        #else
-        FF_DEBUG("Current platform does not support TCP connection timeout");
-        #endif
-    }
-
     return NULL;
-
-error:
-    FF_DEBUG("Error occurred during initialization");
-    if (state->addr != NULL)
-    {
-        FF_DEBUG("Releasing address information");
-        freeaddrinfo(state->addr);
-        state->addr = NULL;
-    }
-
-    if (state->sockfd > 0)
-    {
-        FF_DEBUG("Closing socket: fd=%d", state->sockfd);
-        close(state->sockfd);
-        state->sockfd = -1;
-    }
-    return ret;
 }
 
 const char* ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* host, const char* path, const char* headers)
@@ -333,97 +483,74 @@ const char* ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* ho
     }
     FF_DEBUG("Network state initialization successful");
 
-    const char* tfoResult = tryNonThreadingFastPath(state);
-    if (tfoResult == NULL) {
-        FF_DEBUG("TryNonThreadingFastPath() succeeded or in progress");
-        return NULL;
+    state->sockfd = startConnectingTfo(state);
+    if (state->sockfd >= 0)
+    {
+        state->nextAddr = state->nextAddr->ai_next;
+        state->nextAttempt = ffTimeGetTick() + FF_NETWORKING_ATTEMPT_DELAY;
     }
-    FF_DEBUG("TryNonThreadingFastPath() failed: %s, trying traditional connection", tfoResult);
+    else
+        state->sockfd = connectNextAddr(state);
 
-    #ifdef FF_HAVE_THREADS
-    if (instance.config.general.multithreading)
+    if (state->sockfd == -1)
     {
-        FF_DEBUG("Multithreading mode enabled, creating connection thread");
-        state->thread = ffThreadCreate(connectAndSendThreadMain, state);
-        if (state->thread) {
-            FF_DEBUG("Thread creation successful: thread=%p", (void*)state->thread);
-            return NULL;
-        }
-        FF_DEBUG("Thread creation failed");
-    } else {
-        FF_DEBUG("Multithreading mode disabled, connecting in main thread");
+        failState(state, "connect() failed");
+        return state->error;
     }
-    #endif
 
-    return connectAndSend(state);
+    ffThreadMutexLock(&loop.mutex);
+    if (loop.states.elementSize == 0)
+        ffListInitA(&loop.states, sizeof(FFNetworkingState*), 4);
+    if (loop.pid != getpid())
+    {
+        ffListClear(&loop.states);
+        loop.pid = getpid();
+    }
+    *(FFNetworkingState**) ffListAdd(&loop.states) = state;
+    ffThreadMutexUnlock(&loop.mutex);
+
+    return NULL;
 }
 
-const char* ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buffer)
+static void removeState(FFNetworkingState* state)
 {
-    FF_DEBUG("Preparing to receive HTTP response");
-    uint32_t timeout = state->timeout;
-
-    #ifdef FF_HAVE_THREADS
-    if (state->thread)
+    for (uint32_t i = 0; i < loop.states.length; ++i)
     {
-        FF_DEBUG("Connection thread is running, waiting for it to complete (timeout=%u ms)", timeout);
-        if (!ffThreadJoin(state->thread, timeout)) {
-            FF_DEBUG("Thread join failed or timed out");
-            return "ffThreadJoin() failed or timeout";
+        if (*FF_LIST_GET(FFNetworkingState*, loop.states, i) == state)
+        {
+            // The order doesn't matter
+            *FF_LIST_GET(FFNetworkingState*, loop.states, i) = *FF_LIST_GET(FFNetworkingState*, loop.states, loop.states.length - 1);
+            --loop.states.length;
+            break;
         }
-        FF_DEBUG("Thread completed successfully");
-        state->thread = 0;
     }
-    #endif
+}
 
-    if(state->sockfd == -1)
-    {
-        FF_DEBUG("Invalid socket, HTTP request might have failed");
-        return "ffNetworkingSendHttpRequest() failed";
-    }
+const char* ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buffer)
+{
+    FF_DEBUG("Preparing to receive HTTP response");
+    double deadline = state->timeout > 0 ? ffTimeGetTick() + state->timeout : 0;
 
-    // Set larger initial receive buffer instead of small repeated receives
-    int rcvbuf = 65536; // 64KB
-    setsockopt(state->sockfd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
-
-    #ifdef __APPLE__
-    // poll for the socket to be readable.
-    // Because of the non-blocking connectx() call, the connection might not be established yet
-    FF_DEBUG("Using poll() to check if socket is readable");
-    if (poll(&(struct pollfd) {
-        .fd = state->sockfd,
-        .events = POLLIN
-    }, 1, timeout > 0 ? (int) timeout : -1) == -1)
-    {
-        FF_DEBUG("poll() failed: %s (errno=%d)", strerror(errno), errno);
-        close(state->sockfd);
-        state->sockfd = -1;
-        return "poll() failed";
-    }
-    FF_DEBUG("Socket is readable, proceeding to receive data");
-    #else
-    if(timeout > 0)
-    {
-        FF_DEBUG("Setting receive timeout: %u ms", timeout);
-        struct timeval timev;
-        timev.tv_sec = timeout / 1000;
-        timev.tv_usec = (__typeof__(timev.tv_usec)) ((timeout % 1000) * 1000); //milliseconds to microseconds
-        setsockopt(state->sockfd, SOL_SOCKET, SO_RCVTIMEO, &timev, sizeof(timev));
-    }
-    #endif
+    if (state->error)
+        return state->error;
 
     FF_DEBUG("Starting data reception");
     FF_MAYBE_UNUSED int recvCount = 0;
     uint32_t contentLength = 0;
-    char* headerEnd = NULL;
+    uint32_t headerLength = 0; // Including the end marker, 0 if not received yet. The buffer may be reallocated
 
-    do {
+    ffThreadMutexLock(&loop.mutex);
+    while (runLoop(state, deadline))
+    {
+        ffStrbufEnsureFree(buffer, 4095);
         FF_DEBUG("Data reception loop #%d, current buffer size: %u, available space: %u",
                  ++recvCount, buffer->length, ffStrbufGetFree(buffer));
 
-        ssize_t received = recv(state->sockfd, buffer->chars + buffer->length, ffStrbufGetFree(buffer), MSG_WAITALL);
+        ssize_t received = recv(state->sockfd, buffer->chars + buffer->length, ffStrbufGetFree(buffer), MSG_DONTWAIT);
 
         if (received <= 0) {
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+                continue;
             if (received == 0) {
                 FF_DEBUG("Connection closed (received=0)");
             } else {
@@ -438,10 +565,11 @@ const char* ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buf
         FF_DEBUG("Successfully received %zd bytes of data, total: %u bytes", received, buffer->length);
 
         // Check if HTTP header end marker is found
-        if (headerEnd == NULL) {
-            headerEnd = memmem(buffer->chars, buffer->length, "\r\n\r\n", 4);
+        if (headerLength == 0) {
+            const char* headerEnd = memmem(buffer->chars, buffer->length, "\r\n\r\n", 4);
             if (headerEnd != NULL) {
-                FF_DEBUG("Found HTTP header end marker, position: %ld", (long)(headerEnd - buffer->chars));
+                headerLength = (uint32_t) (headerEnd - buffer->chars) + 4;
+                FF_DEBUG("Found HTTP header end marker, position: %u", headerLength - 4);
 
                 // Check for Content-Length header to pre-allocate enough memory
                 const char* clHeader = strcasestr(buffer->chars, "Content-Length:");
@@ -449,30 +577,38 @@ const char* ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buf
                     contentLength = (uint32_t) strtoul(clHeader + 16, NULL, 10);
                     if (contentLength > 0) {
                         FF_DEBUG("Detected Content-Length: %u, pre-allocating buffer", contentLength);
-                        // Ensure buffer is large enough, adding header size and some margin
+                        // Ensure buffer is large enough, adding some margin
                         ffStrbufEnsureFree(buffer, contentLength + 16);
-                        FF_DEBUG("Extended receive buffer to %u bytes", buffer->length);
                     }
                 }
             }
         }
-    } while (ffStrbufGetFree(buffer) > 0);
+
+        // Don't wait for the server to close the connection
+        if (headerLength > 0 && contentLength > 0 && buffer->length >= headerLength + contentLength)
+            break;
+    }
+
+    removeState(state);
+    ffThreadMutexUnlock(&loop.mutex);
 
     FF_DEBUG("Closing socket: fd=%d", state->sockfd);
-    close(state->sockfd);
-    state->sockfd = -1;
+    closeSocket(&state->sockfd);
+    releaseState(state);
+    if (state->error)
+        return state->error;
 
     if (buffer->length == 0) {
         FF_DEBUG("Server response is empty");
         return "Empty server response received";
     }
 
-    if (headerEnd == NULL) {
+    if (headerLength == 0) {
         FF_DEBUG("No HTTP header end marker found");
         return "No HTTP header end found";
     }
-    if (contentLength > 0 && buffer->length != contentLength + (uint32_t)(headerEnd - buffer->chars) + 4) {
-        FF_DEBUG("Received content length mismatches: %u != %u", buffer->length, contentLength + (uint32_t)(headerEnd - buffer->chars) + 4);
+    if (contentLength > 0 && buffer->length != headerLength + contentLength) {
+        FF_DEBUG("Received content length mismatches: %u != %u", buffer->length, headerLength + contentLength);
         return "Content length mismatch";
     }
 
@@ -487,7 +623,7 @@ const char* ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buf
     #ifdef FF_HAVE_ZLIB
     if (state->compression) {
         FF_DEBUG("Content received, checking if compressed");
-        if (!ffNetworkingDecompressGzip(buffer, headerEnd)) {
+        if (!ffNetworkingDecompressGzip(buffer, buffer->chars + headerLength - 4)) {
             FF_DEBUG("Decompression failed or invalid compression format");
             return "Failed to decompress or invalid format";
         } else {
@@ -4,6 +4,7 @@
 //Must be included after <mswsock.h>
 #include "fastfetch.h"
 #include "common/networking/networking.h"
+#include "common/thread.h"
 #include "util/stringUtils.h"
 #include "util/debug.h"
 
@@ -72,20 +73,14 @@ const char* ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* ho
     }
 
     static WSADATA wsaData;
-    if (wsaData.wVersion == 0)
+    static const char* wsaError;
+    static FFThreadOnce wsaOnce = FF_THREAD_ONCE_INITIALIZER;
+    FF_ONCE(&wsaOnce)
+        wsaError = initWsaData(&wsaData);
+    if (wsaError != NULL)
     {
-        const char* error = initWsaData(&wsaData);
-        if (error != NULL)
-        {
-            wsaData.wVersion = (WORD) -1;
-            FF_DEBUG("WinSock initialization failed: %s", error);
-            return error;
-        }
-    }
-    else if (wsaData.wVersion == (WORD) -1)
-    {
-        FF_DEBUG("WinSock initialization previously failed");
-        return "initWsaData() failed before";
+        FF_DEBUG("WinSock initialization failed: %s", wsaError);
+        return wsaError;
     }
 
     struct addrinfo* addr;
@@ -31,6 +31,12 @@ typedef struct FFModuleBaseInfo
     // https://stackoverflow.com/questions/559581/casting-a-function-pointer-to-another-type
     bool (*parseCommandOptions)(void* options, const char* key, const char* value);
     void (*parseJsonObject)(void* options, struct yyjson_val *module);
+    // Optional. Called for each occurrence of the module as soon as the config is parsed, before the logo is printed.
+    // Used to start measurements that need a time interval, or requests that take long to finish
+    void (*prepareModule)(void* options);
+    // Optional. Runs the detection of the module and keeps the result for the next `printModule` or `generateJsonResult` call,
+    // which detect by themselves if it is not called. May be called from a detection thread
+    void (*detectModule)(void* options);
     void (*printModule)(void* options);
     void (*generateJsonResult)(void* options, struct yyjson_mut_doc* doc, struct yyjson_mut_val* module);
     void (*generateJsonConfig)(void* options, struct yyjson_mut_doc* doc, struct yyjson_mut_val* obj);
@@ -4,7 +4,42 @@
 
 #include <sys/types.h>
 
-const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool useStdErr);
+typedef struct FFProcessHandle
+{
+    FFstrbuf* buffer;
+    const char* error; // Set by `ffProcessSpawn` or `ffProcessWaitAll`
+
+    #ifdef _WIN32
+    void* hProcess;
+    void* hPipeRead;
+    #else
+    pid_t pid;
+    int pipeRead;
+    #endif
+} FFProcessHandle;
+
+// Starts a child process without waiting for it. Its stdout, or stderr if `useStdErr`, is appended to `buffer` by `ffProcessWaitAll`
+const char* ffProcessSpawn(FFProcessHandle* handle, FFstrbuf* buffer, char* const argv[], bool useStdErr);
+
+// Reads outputs of all child processes at once and waits for them to exit, within `general.processingTimeout` in total.
+// Handles whose spawning failed are skipped
+void ffProcessWaitAll(FFProcessHandle* handles, uint32_t count);
+
+// Starts a child process that outlives us, with its stdin, stdout and stderr redirected to the null device.
+// Unix only
+const char* ffProcessSpawnDetached(char* const argv[]);
+
+// Runs `func` in a forked process that outlives us, with its stdin, stdout and stderr redirected to the null device.
+// Multithreading is disabled in the child. Unix only
+const char* ffProcessForkDetached(void (*func)(void* data), void* data);
+
+static inline const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool useStdErr)
+{
+    FFProcessHandle handle;
+    if (!ffProcessSpawn(&handle, buffer, argv, useStdErr))
+        ffProcessWaitAll(&handle, 1);
+    return handle.error;
+}
 
 static inline const char* ffProcessAppendStdOut(FFstrbuf* buffer, char* const argv[])
 {
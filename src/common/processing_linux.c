@@ -1,6 +1,9 @@
 #include "fastfetch.h"
 #include "common/processing.h"
 #include "common/io/io.h"
+#include "common/thread.h"
+#include "common/time.h"
+#include "util/FFlist.h"
 #include "util/stringUtils.h"
 #include "util/mallocHelper.h"
 
@@ -11,6 +14,16 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <sys/wait.h>
+#include <sys/stat.h>
+
+#ifdef FF_HAVE_POSIX_SPAWN
+    #include <spawn.h>
+#endif
+
+#ifdef __linux__
+    #include "common/proctable.h"
+    #include <sys/syscall.h>
+#endif
 
 #if defined(__FreeBSD__) || defined(__APPLE__)
     #include <sys/types.h>
@@ -48,20 +61,140 @@ static inline int ffPipe2(int* fds, int flags)
     #endif
 }
 
-const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool useStdErr)
+extern char** environ;
+
+typedef struct FFExecutablePath
 {
-    int pipes[2];
-    const int timeout = instance.config.general.processingTimeout;
+    FFstrbuf name;
+    FFstrbuf path; // Empty if not found
+} FFExecutablePath;
+
+// Resolves `name` like `execvp` does. Results are cached because PATH doesn't change during a run
+static bool findExecutable(const char* name, FFstrbuf* path)
+{
+    if (strchr(name, '/'))
+    {
+        ffStrbufSetS(path, name);
+        return true;
+    }
+
+    static FFThreadMutex mutex = FF_THREAD_MUTEX_INITIALIZER;
+    static FFlist cache = { .elementSize = sizeof(FFExecutablePath) };
+
+    ffThreadMutexLock(&mutex);
+
+    FF_LIST_FOR_EACH(FFExecutablePath, item, cache)
+    {
+        if (ffStrbufEqualS(&item->name, name))
+        {
+            ffStrbufSet(path, &item->path);
+            ffThreadMutexUnlock(&mutex);
+            return path->length > 0;
+        }
+    }
+
+    ffStrbufClear(path);
+    const char* paths = getenv("PATH");
+    if (!paths || !*paths) paths = "/bin:/usr/bin";
 
+    while (true)
+    {
+        const char* end = strchr(paths, ':');
+        uint32_t length = end ? (uint32_t) (end - paths) : (uint32_t) strlen(paths);
+
+        // An empty entry means the current directory
+        if (length == 0)
+            ffStrbufSetS(path, "./");
+        else
+        {
+            ffStrbufSetNS(path, length, paths);
+            ffStrbufEnsureEndsWithC(path, '/');
+        }
+        ffStrbufAppendS(path, name);
+
+        struct stat st;
+        if (stat(path->chars, &st) == 0 && S_ISREG(st.st_mode) && access(path->chars, X_OK) == 0)
+            break;
+
+        ffStrbufClear(path);
+        if (!end) break;
+        paths = end + 1;
+    }
+
+    FFExecutablePath* item = ffListAdd(&cache);
+    ffStrbufInitS(&item->name, name);
+    ffStrbufInitCopy(&item->path, path);
+
+    ffThreadMutexUnlock(&mutex);
+    return path->length > 0;
+}
+
+// Our environment with `LANG=C`, built once, so that children don't need to modify theirs
+static char* const* getChildEnvironment(void)
+{
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+    static char** envp;
+
+    FF_ONCE(&once)
+    {
+        uint32_t count = 0;
+        while (environ[count]) ++count;
+
+        envp = malloc((count + 2) * sizeof(*envp));
+        uint32_t index = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (!ffStrStartsWith(environ[i], "LANG="))
+                envp[index++] = environ[i];
+        }
+        envp[index++] = "LANG=C";
+        envp[index] = NULL;
+    }
+
+    return envp;
+}
+
+const char* ffProcessSpawn(FFProcessHandle* handle, FFstrbuf* buffer, char* const argv[], bool useStdErr)
+{
+    *handle = (FFProcessHandle) { .buffer = buffer, .pid = -1, .pipeRead = -1 };
+
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    if (!findExecutable(argv[0], &path))
+        return handle->error = "command was not found";
+
+    char* const* envp = getChildEnvironment();
+
+    int pipes[2];
     if(ffPipe2(pipes, O_CLOEXEC) == -1)
-        return "pipe() failed";
+        return handle->error = "pipe() failed";
 
-    pid_t childPid = fork();
+    pid_t childPid = -1;
+
+    #ifdef FF_HAVE_POSIX_SPAWN
+
+    // Unlike `fork`, `posix_spawn` doesn't copy our page tables
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, pipes[1], useStdErr ? STDERR_FILENO : STDOUT_FILENO);
+    posix_spawn_file_actions_addopen(&actions, useStdErr ? STDOUT_FILENO : STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+    int ret = posix_spawn(&childPid, path.chars, &actions, NULL, argv, envp);
+    posix_spawn_file_actions_destroy(&actions);
+
+    if (ret != 0)
+    {
+        close(pipes[0]);
+        close(pipes[1]);
+        return handle->error = ret == ENOENT ? "command was not found" : "posix_spawn() failed";
+    }
+
+    #else
+
+    childPid = fork();
     if(childPid == -1)
     {
         close(pipes[0]);
         close(pipes[1]);
-        return "fork() failed";
+        return handle->error = "fork() failed";
     }
 
     //Child
@@ -70,73 +203,233 @@ const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool use
         int nullFile = open("/dev/null", O_WRONLY | O_CLOEXEC);
         dup2(pipes[1], useStdErr ? STDERR_FILENO : STDOUT_FILENO);
         dup2(nullFile, useStdErr ? STDOUT_FILENO : STDERR_FILENO);
-        setenv("LANG", "C", 1);
-        execvp(argv[0], argv);
+        execve(path.chars, argv, envp);
         _exit(127);
     }
 
+    #endif
+
     //Parent
     close(pipes[1]);
+    handle->pid = childPid;
+    handle->pipeRead = pipes[0];
+    return NULL;
+}
+
+const char* ffProcessSpawnDetached(char* const argv[])
+{
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    if (!findExecutable(argv[0], &path))
+        return "command was not found";
+
+    char* const* envp = getChildEnvironment();
+    pid_t childPid = -1;
+
+    #ifdef FF_HAVE_POSIX_SPAWN
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    #ifdef POSIX_SPAWN_SETSID
+    // Not killed by SIGHUP when the terminal is closed
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSID);
+    #endif
+    int ret = posix_spawn(&childPid, path.chars, &actions, &attr, argv, envp);
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+
+    if (ret != 0)
+        return ret == ENOENT ? "command was not found" : "posix_spawn() failed";
+
+    #else
+
+    childPid = fork();
+    if (childPid == -1)
+        return "fork() failed";
+
+    if (childPid == 0)
+    {
+        setsid();
+        int nullFile = open("/dev/null", O_RDWR | O_CLOEXEC);
+        dup2(nullFile, STDIN_FILENO);
+        dup2(nullFile, STDOUT_FILENO);
+        dup2(nullFile, STDERR_FILENO);
+        execve(path.chars, argv, envp);
+        _exit(127);
+    }
+
+    #endif
+
+    // The child is reaped by init once we exit
+    return NULL;
+}
+
+const char* ffProcessForkDetached(void (*func)(void* data), void* data)
+{
+    fflush(stdout);
+    fflush(stderr);
+
+    pid_t childPid = fork();
+    if (childPid == -1)
+        return "fork() failed";
+
+    if (childPid == 0)
+    {
+        // Only the calling thread exists in the child. Nothing may be printed, or wait for the thread pool
+        setsid();
+        int nullFile = open("/dev/null", O_RDWR | O_CLOEXEC);
+        dup2(nullFile, STDIN_FILENO);
+        dup2(nullFile, STDOUT_FILENO);
+        dup2(nullFile, STDERR_FILENO);
+        instance.config.general.multithreading = false;
+        func(data);
+        _exit(0);
+    }
+
+    // The child is reaped by init once we exit
+    return NULL;
+}
+
+static int openPidfd(FF_MAYBE_UNUSED pid_t pid)
+{
+    // Readable once the process exits. The process can't be reaped by others, so its pid can't be reused meanwhile
+    #if defined(__linux__) && defined(SYS_pidfd_open)
+        return (int) syscall(SYS_pidfd_open, pid, 0);
+    #else
+        return -1;
+    #endif
+}
+
+static const char* getExitError(int stat_loc)
+{
+    if (!WIFEXITED(stat_loc))
+        return "child process exited abnormally";
+    if (WEXITSTATUS(stat_loc) == 127)
+        return "command was not found";
+    // We only handle 127 as an error. See `getTerminalVersionUrxvt` in `terminalshell.c`
+    return NULL;
+}
+
+static void finishProcess(FFProcessHandle* handle, struct pollfd* fds, const char* error)
+{
+    close(fds[0].fd);
+    if (fds[1].fd >= 0)
+        close(fds[1].fd);
+    fds[0].fd = fds[1].fd = -1;
+
+    handle->pid = -1;
+    handle->pipeRead = -1;
+    handle->error = error;
+}
+
+static void killProcess(FFProcessHandle* handle, struct pollfd* fds, const char* error)
+{
+    kill(handle->pid, SIGTERM);
+    waitpid(handle->pid, NULL, 0);
+    finishProcess(handle, fds, error);
+}
+
+void ffProcessWaitAll(FFProcessHandle* handles, uint32_t count)
+{
+    const int timeout = instance.config.general.processingTimeout;
+    const double deadline = ffTimeGetTick() + timeout;
+
+    // fds[i * 2] is the pipe of handles[i], and fds[i * 2 + 1] is its pidfd. `poll` ignores negative fds
+    FF_AUTO_FREE struct pollfd* fds = malloc(count * 2 * sizeof(*fds));
+    uint32_t running = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (handles[i].pid < 0)
+        {
+            fds[i * 2] = fds[i * 2 + 1] = (struct pollfd) { .fd = -1 };
+            continue;
+        }
+        fds[i * 2] = (struct pollfd) { handles[i].pipeRead, POLLIN, 0 };
+        fds[i * 2 + 1] = (struct pollfd) { openPidfd(handles[i].pid), POLLIN, 0 };
+        ++running;
+    }
 
-    int FF_AUTO_CLOSE_FD childPipeFd = pipes[0];
     char str[FF_PIPE_BUFSIZ];
+    const char* error = "poll() timeout (try increasing --processing-timeout)";
 
-    while(1)
+    while (running > 0)
     {
+        int wait = -1;
         if (timeout >= 0)
         {
-            struct pollfd pollfd = { childPipeFd, POLLIN, 0 };
-            if (poll(&pollfd, 1, timeout) == 0)
-            {
-                kill(childPid, SIGTERM);
-                waitpid(childPid, NULL, 0);
-                return "poll(&pollfd, 1, timeout) timeout (try increasing --processing-timeout)";
-            }
-            else if (errno == EINTR)
+            double remaining = deadline - ffTimeGetTick();
+            wait = remaining > 0 ? (int) remaining + 1 : 0;
+        }
+
+        int ready = poll(fds, count * 2, wait);
+        if (ready == 0)
+            break;
+        if (ready < 0 && errno != EINTR)
+        {
+            error = "poll() failed";
+            break;
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            FFProcessHandle* handle = &handles[i];
+            struct pollfd* pfds = &fds[i * 2];
+            if (pfds[0].fd < 0) continue;
+
+            // The pidfd is readable, or `poll` is interrupted by SIGCHLD. See `chldSignalHandler` in `common/init.c`
+            int stat_loc = 0;
+            if (ready < 0 || pfds[1].revents)
             {
-                // The child process has been terminated. See `chldSignalHandler` in `common/init.c`
-                if (waitpid(childPid, NULL, WNOHANG) == childPid)
+                if (waitpid(handle->pid, &stat_loc, WNOHANG) == handle->pid)
                 {
-                    // Read remaining data from the pipe
-                    fcntl(childPipeFd, F_SETFL, O_CLOEXEC | O_NONBLOCK);
-                    childPid = -1;
+                    // Read remaining data from the pipe, which may be kept open by grandchildren
+                    fcntl(pfds[0].fd, F_SETFL, O_CLOEXEC | O_NONBLOCK);
+                    ssize_t nRead;
+                    while ((nRead = read(pfds[0].fd, str, FF_PIPE_BUFSIZ)) > 0)
+                        ffStrbufAppendNS(handle->buffer, (uint32_t) nRead, str);
+                    finishProcess(handle, pfds, getExitError(stat_loc));
+                    --running;
+                    continue;
+                }
+                if (pfds[1].revents)
+                {
+                    // Should not happen. Wait for the pipe only
+                    close(pfds[1].fd);
+                    pfds[1].fd = -1;
                 }
             }
-            else if (pollfd.revents & POLLERR)
+
+            if (ready < 0 || !pfds[0].revents) continue;
+
+            ssize_t nRead = read(pfds[0].fd, str, FF_PIPE_BUFSIZ);
+            if (nRead > 0)
+                ffStrbufAppendNS(handle->buffer, (uint32_t) nRead, str);
+            else if (nRead == 0)
             {
-                kill(childPid, SIGTERM);
-                waitpid(childPid, NULL, 0);
-                return "poll(&pollfd, 1, timeout) error";
+                const char* exitError = NULL;
+                if (waitpid(handle->pid, &stat_loc, 0) == handle->pid)
+                    exitError = getExitError(stat_loc);
+                finishProcess(handle, pfds, exitError);
+                --running;
             }
-        }
-
-        ssize_t nRead = read(childPipeFd, str, FF_PIPE_BUFSIZ);
-        if (nRead > 0)
-            ffStrbufAppendNS(buffer, (uint32_t) nRead, str);
-        else if (nRead == 0)
-        {
-            int stat_loc = 0;
-            if (childPid > 0 && waitpid(childPid, &stat_loc, 0) == childPid)
+            else if (errno != EINTR && errno != EAGAIN)
             {
-                if (!WIFEXITED(stat_loc))
-                    return "child process exited abnormally";
-                if (WEXITSTATUS(stat_loc) == 127)
-                    return "command was not found";
-                // We only handle 127 as an error. See `getTerminalVersionUrxvt` in `terminalshell.c`
-                return NULL;
+                killProcess(handle, pfds, "read(childPipeFd, str, FF_PIPE_BUFSIZ) failed");
+                --running;
             }
-            return NULL;
         }
-        else if (nRead < 0)
-        {
-            if (errno == EAGAIN)
-                return NULL;
-            else
-                break;
-        }
-    };
+    }
 
-    return "read(childPipeFd, str, FF_PIPE_BUFSIZ) failed";
+    for (uint32_t i = 0; running > 0 && i < count; ++i)
+    {
+        if (fds[i * 2].fd < 0) continue;
+        killProcess(&handles[i], &fds[i * 2], error);
+        --running;
+    }
 }
 
 void ffProcessGetInfoLinux(pid_t pid, FFstrbuf* processName, FFstrbuf* exe, const char** exeName, FFstrbuf* exePath)
@@ -346,39 +639,15 @@ const char* ffProcessGetBasicInfoLinux(pid_t pid, FFstrbuf* name, pid_t* ppid, i
 
     #ifdef __linux__
 
-    char procFilePath[64];
+    const FFProcInfo* proc = ffProcTableGet(pid, FF_PROC_INFO_STAT);
+    if (proc == NULL)
+        return "ffProcTableGet(pid, FF_PROC_INFO_STAT) failed";
+
+    ffStrbufSet(name, &proc->comm);
     if (ppid)
-    {
-        snprintf(procFilePath, sizeof(procFilePath), "/proc/%d/stat", (int)pid);
-        char buf[PROC_FILE_BUFFSIZ];
-        ssize_t nRead = ffReadFileData(procFilePath, sizeof(buf) - 1, buf);
-        if(nRead <= 8)
-            return "ffReadFileData(/proc/pid/stat, PROC_FILE_BUFFSIZ-1, buf) failed";
-        buf[nRead] = '\0';
-
-        *ppid = 0;
-        static_assert(sizeof(*ppid) == sizeof(int), "");
-
-        ffStrbufEnsureFixedLengthFree(name, 255);
-        int tty_;
-        if(
-            sscanf(buf, "%*s (%255[^)]) %*c %d %*d %*d %d", name->chars, ppid, &tty_) < 2 || //stat (comm) state ppid pgrp session tty
-            name->chars[0] == '\0'
-        )
-            return "sscanf(stat) failed";
-
-        ffStrbufRecalculateLength(name);
-        if (tty)
-            *tty = tty_ & 0xFF;
-    }
-    else
-    {
-        snprintf(procFilePath, sizeof(procFilePath), "/proc/%d/comm", (int)pid);
-        ssize_t nRead = ffReadFileBuffer(procFilePath, name);
-        if(nRead <= 0)
-            return "ffReadFileBuffer(/proc/pid/comm, name) failed";
-        ffStrbufTrimRightSpace(name);
-    }
+        *ppid = proc->ppid;
+    if (tty)
+        *tty = proc->tty;
 
     #elif defined(__APPLE__)
 
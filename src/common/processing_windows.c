@@ -1,6 +1,7 @@
 #include "fastfetch.h"
 #include "common/processing.h"
 #include "common/io/io.h"
+#include "common/time.h"
 
 #include <Windows.h>
 #include <ntstatus.h>
@@ -45,16 +46,17 @@ static void argvToCmdline(char* const argv[], FFstrbuf* result)
     }
 }
 
-const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool useStdErr)
+const char* ffProcessSpawn(FFProcessHandle* handle, FFstrbuf* buffer, char* const argv[], bool useStdErr)
 {
-    int timeout = instance.config.general.processingTimeout;
+    *handle = (FFProcessHandle) { .buffer = buffer, .hProcess = NULL, .hPipeRead = INVALID_HANDLE_VALUE };
 
-    wchar_t pipeName[32];
-    swprintf(pipeName, ARRAY_SIZE(pipeName), L"\\\\.\\pipe\\FASTFETCH-%u", GetCurrentProcessId());
+    static volatile LONG pipeCounter;
+    wchar_t pipeName[48];
+    swprintf(pipeName, ARRAY_SIZE(pipeName), L"\\\\.\\pipe\\FASTFETCH-%u-%ld", GetCurrentProcessId(), InterlockedIncrement(&pipeCounter));
 
-    FF_AUTO_CLOSE_FD HANDLE hChildPipeRead = CreateNamedPipeW(
+    HANDLE hChildPipeRead = CreateNamedPipeW(
         pipeName,
-        PIPE_ACCESS_INBOUND | FILE_FLAG_FIRST_PIPE_INSTANCE | (timeout < 0 ? 0 : FILE_FLAG_OVERLAPPED),
+        PIPE_ACCESS_INBOUND | FILE_FLAG_FIRST_PIPE_INSTANCE | (instance.config.general.processingTimeout < 0 ? 0 : FILE_FLAG_OVERLAPPED),
         0,
         1,
         FF_PIPE_BUFSIZ,
@@ -63,7 +65,7 @@ const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool use
         NULL
     );
     if (hChildPipeRead == INVALID_HANDLE_VALUE)
-        return "CreateNamedPipeW(L\"\\\\.\\pipe\\FASTFETCH-$(PID)\") failed";
+        return handle->error = "CreateNamedPipeW(L\"\\\\.\\pipe\\FASTFETCH-$(PID)-$(N)\") failed";
 
     HANDLE hChildPipeWrite = CreateFileW(
         pipeName,
@@ -79,7 +81,10 @@ const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool use
         NULL
     );
     if (hChildPipeWrite == INVALID_HANDLE_VALUE)
-        return "CreateFileW(L\"\\\\.\\pipe\\FASTFETCH-$(PID)\") failed";
+    {
+        CloseHandle(hChildPipeRead);
+        return handle->error = "CreateFileW(L\"\\\\.\\pipe\\FASTFETCH-$(PID)-$(N)\") failed";
+    }
 
     PROCESS_INFORMATION piProcInfo = {0};
 
@@ -114,10 +119,21 @@ const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool use
 
     CloseHandle(hChildPipeWrite);
     if(!success)
-        return "CreateProcessA() failed";
+    {
+        CloseHandle(hChildPipeRead);
+        return handle->error = "CreateProcessA() failed";
+    }
 
-    FF_AUTO_CLOSE_FD HANDLE hProcess = piProcInfo.hProcess;
-    FF_MAYBE_UNUSED FF_AUTO_CLOSE_FD HANDLE hThread = piProcInfo.hThread;
+    CloseHandle(piProcInfo.hThread);
+    handle->hProcess = piProcInfo.hProcess;
+    handle->hPipeRead = hChildPipeRead;
+    return NULL;
+}
+
+static const char* readOutput(FFProcessHandle* handle, double deadline)
+{
+    int timeout = instance.config.general.processingTimeout;
+    HANDLE hChildPipeRead = handle->hPipeRead;
 
     char str[FF_PIPE_BUFSIZ];
     DWORD nRead = 0;
@@ -130,10 +146,12 @@ const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool use
             switch (GetLastError())
             {
             case ERROR_IO_PENDING:
-                if (!timeout || WaitForSingleObject(hChildPipeRead, (DWORD) timeout) != WAIT_OBJECT_0)
+            {
+                double remaining = deadline - ffTimeGetTick();
+                if (!timeout || remaining <= 0 || WaitForSingleObject(hChildPipeRead, (DWORD) remaining + 1) != WAIT_OBJECT_0)
                 {
                     CancelIo(hChildPipeRead);
-                    TerminateProcess(hProcess, 1);
+                    TerminateProcess(handle->hProcess, 1);
                     return "WaitForSingleObject(hChildPipeRead) failed or timeout (try increasing --processing-timeout)";
                 }
 
@@ -143,26 +161,56 @@ const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool use
                         return NULL;
 
                     CancelIo(hChildPipeRead);
-                    TerminateProcess(hProcess, 1);
+                    TerminateProcess(handle->hProcess, 1);
                     return "GetOverlappedResult(hChildPipeRead) failed";
                 }
                 break;
+            }
 
             case ERROR_BROKEN_PIPE:
                 return NULL;
 
             default:
                 CancelIo(hChildPipeRead);
-                TerminateProcess(hProcess, 1);
+                TerminateProcess(handle->hProcess, 1);
                 return "ReadFile(hChildPipeRead) failed";
             }
         }
-        ffStrbufAppendNS(buffer, nRead, str);
+        ffStrbufAppendNS(handle->buffer, nRead, str);
     } while (nRead > 0);
 
     return NULL;
 }
 
+const char* ffProcessSpawnDetached(FF_MAYBE_UNUSED char* const argv[])
+{
+    return "Not supported on Windows";
+}
+
+const char* ffProcessForkDetached(FF_MAYBE_UNUSED void (*func)(void* data), FF_MAYBE_UNUSED void* data)
+{
+    return "Not supported on Windows";
+}
+
+void ffProcessWaitAll(FFProcessHandle* handles, uint32_t count)
+{
+    double deadline = ffTimeGetTick() + instance.config.general.processingTimeout;
+
+    // The processes run concurrently. They block only when their pipe buffers are full
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        FFProcessHandle* handle = &handles[i];
+        if (!handle->hProcess) continue;
+
+        handle->error = readOutput(handle, deadline);
+
+        CloseHandle(handle->hPipeRead);
+        CloseHandle(handle->hProcess);
+        handle->hPipeRead = INVALID_HANDLE_VALUE;
+        handle->hProcess = NULL;
+    }
+}
+
 bool ffProcessGetInfoWindows(uint32_t pid, uint32_t* ppid, FFstrbuf* pname, FFstrbuf* exe, const char** exeName, FFstrbuf* exePath, bool* gui)
 {
     FF_AUTO_CLOSE_FD HANDLE hProcess = pid == 0
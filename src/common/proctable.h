@@ -0,0 +1,37 @@
+#pragma once
+
+#include "fastfetch.h"
+
+#include <sys/types.h>
+
+// A process-table snapshot of `/proc`, shared by every detection that walks processes. Linux only.
+// Nothing is read until it's queried: the pid list is built by a single pass over `/proc` when it's first requested,
+// and each field of a process is read once, when it's first requested for that process
+
+typedef enum __attribute__((__packed__)) FFProcInfoField
+{
+    FF_PROC_INFO_STAT = 1 << 0, // `ppid`, `tty` and `comm`
+    FF_PROC_INFO_UID = 1 << 1,
+    FF_PROC_INFO_LOGINUID = 1 << 2,
+    FF_PROC_INFO_EXE_NAME = 1 << 3,
+} FFProcInfoField;
+
+typedef struct FFProcInfo
+{
+    pid_t pid;
+    pid_t ppid;
+    int32_t tty; // Minor device number of the controlling terminal
+    uint32_t uid; // Effective user ID
+    uint32_t loginuid; // `(uint32_t) -1` if not set
+    FFstrbuf comm; // Process name, truncated to 15 characters by the kernel
+    FFstrbuf exeName; // Base name of argv[0]
+    FFProcInfoField loaded; // Fields that have been read
+    FFProcInfoField failed; // Fields that can't be read, typically because the process has exited
+} FFProcInfo;
+
+// Copies the pids of all processes into `pids` (pid_t). Returns false if `/proc` can't be listed
+bool ffProcTableGetPids(FFlist* pids);
+
+// Returns the process with `fields` read, or NULL if any of them can't be read.
+// The returned process and its requested fields stay valid and unchanged for the rest of the run
+const FFProcInfo* ffProcTableGet(pid_t pid, FFProcInfoField fields);
@@ -0,0 +1,199 @@
+#include "common/proctable.h"
+#include "common/io/io.h"
+#include "common/thread.h"
+#include "util/stringUtils.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+static struct
+{
+    FFThreadMutex mutex;
+    FFlist procs; // FFProcInfo*, sorted by pid. Elements are allocated separately, so pointers to them stay valid
+    FFlist pids; // pid_t, in the order of `/proc`
+    bool listed; // `pids` is set
+    bool listFailed;
+} table = { .mutex = FF_THREAD_MUTEX_INITIALIZER };
+
+static bool listPids(void)
+{
+    FF_AUTO_CLOSE_DIR DIR* dir = opendir("/proc");
+    if (dir == NULL)
+        return false;
+
+    ffListInitA(&table.pids, sizeof(pid_t), 512);
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (
+        #ifdef _DIRENT_HAVE_D_TYPE
+            entry->d_type == DT_DIR &&
+        #endif
+            ffCharIsDigit(entry->d_name[0])
+        )
+            *(pid_t*) ffListAdd(&table.pids) = (pid_t) strtol(entry->d_name, NULL, 10);
+    }
+    return true;
+}
+
+bool ffProcTableGetPids(FFlist* pids)
+{
+    ffThreadMutexLock(&table.mutex);
+    if (!table.listed)
+    {
+        table.listed = true;
+        table.listFailed = !listPids();
+    }
+    bool ok = !table.listFailed;
+    if (ok)
+    {
+        ffListClear(pids);
+        for (uint32_t i = 0; i < table.pids.length; ++i)
+            *(pid_t*) ffListAdd(pids) = *FF_LIST_GET(pid_t, table.pids, i);
+    }
+    ffThreadMutexUnlock(&table.mutex);
+    return ok;
+}
+
+// Returns the index of `pid` in `table.procs`, or where it should be inserted
+static uint32_t findProc(pid_t pid)
+{
+    uint32_t low = 0, high = table.procs.length;
+    while (low < high)
+    {
+        uint32_t mid = low + (high - low) / 2;
+        if ((*FF_LIST_GET(FFProcInfo*, table.procs, mid))->pid < pid)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+// `path` is `/proc/<pid>/`, with room for the file name
+static bool readStat(FFProcInfo* proc, char* path, uint32_t prefixLength)
+{
+    strcpy(path + prefixLength, "stat");
+    char buf[PROC_FILE_BUFFSIZ];
+    ssize_t nRead = ffReadFileData(path, sizeof(buf) - 1, buf);
+    if (nRead <= 8)
+        return false;
+    buf[nRead] = '\0';
+
+    // pid (comm) state ppid pgrp session tty_nr. `comm` may contain anything, including spaces and parentheses
+    const char* commStart = strchr(buf, '(');
+    const char* commEnd = strrchr(buf, ')');
+    if (commStart == NULL || commEnd == NULL || commEnd <= commStart + 1)
+        return false;
+
+    int ppid = 0, tty = 0;
+    if (sscanf(commEnd + 1, " %*c %d %*d %*d %d", &ppid, &tty) < 1)
+        return false;
+
+    ffStrbufSetNS(&proc->comm, (uint32_t) (commEnd - commStart - 1), commStart + 1);
+    proc->ppid = (pid_t) ppid;
+    proc->tty = tty & 0xFF;
+    return true;
+}
+
+static bool readUid(FFProcInfo* proc, char* path, uint32_t prefixLength)
+{
+    // The owner of the directory, which costs a single syscall
+    path[prefixLength] = '\0';
+    struct stat st;
+    if (stat(path, &st) != 0)
+        return false;
+    proc->uid = (uint32_t) st.st_uid;
+    return true;
+}
+
+static bool readLoginuid(FFProcInfo* proc, char* path, uint32_t prefixLength)
+{
+    strcpy(path + prefixLength, "loginuid");
+    char buf[16];
+    ssize_t nRead = ffReadFileData(path, sizeof(buf) - 1, buf);
+    if (nRead <= 0)
+        return false;
+    buf[nRead] = '\0';
+
+    char* end;
+    unsigned long loginuid = strtoul(buf, &end, 10);
+    proc->loginuid = end == buf ? (uint32_t) -1 : (uint32_t) loginuid;
+    return true;
+}
+
+static bool readExeName(FFProcInfo* proc, char* path, uint32_t prefixLength)
+{
+    // We check the cmdline for the process name, because it is not truncated
+    strcpy(path + prefixLength, "cmdline");
+    if (!ffReadFileBuffer(path, &proc->exeName))
+        return false;
+    ffStrbufTrimRightSpace(&proc->exeName);
+    ffStrbufSubstrBeforeFirstC(&proc->exeName, '\0'); // Trim the arguments
+    ffStrbufSubstrAfterLastC(&proc->exeName, '/');
+    return true;
+}
+
+static void loadFields(FFProcInfo* proc, FFProcInfoField fields)
+{
+    static const struct
+    {
+        FFProcInfoField field;
+        bool (*read)(FFProcInfo* proc, char* path, uint32_t prefixLength);
+    } readers[] = {
+        { FF_PROC_INFO_STAT, readStat },
+        { FF_PROC_INFO_UID, readUid },
+        { FF_PROC_INFO_LOGINUID, readLoginuid },
+        { FF_PROC_INFO_EXE_NAME, readExeName },
+    };
+
+    char path[64];
+    uint32_t prefixLength = (uint32_t) snprintf(path, sizeof(path), "/proc/%d/", (int) proc->pid);
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(readers); ++i)
+    {
+        if (!(fields & readers[i].field))
+            continue;
+        if (readers[i].read(proc, path, prefixLength))
+            proc->loaded |= readers[i].field;
+        else
+            proc->failed |= readers[i].field;
+    }
+}
+
+const FFProcInfo* ffProcTableGet(pid_t pid, FFProcInfoField fields)
+{
+    if (pid <= 0)
+        return NULL;
+
+    ffThreadMutexLock(&table.mutex);
+
+    if (table.procs.elementSize == 0)
+        ffListInitA(&table.procs, sizeof(FFProcInfo*), 64);
+
+    uint32_t index = findProc(pid);
+    FFProcInfo* proc;
+    if (index < table.procs.length && (*FF_LIST_GET(FFProcInfo*, table.procs, index))->pid == pid)
+        proc = *FF_LIST_GET(FFProcInfo*, table.procs, index);
+    else
+    {
+        proc = calloc(1, sizeof(*proc));
+        proc->pid = pid;
+        ffStrbufInit(&proc->comm);
+        ffStrbufInit(&proc->exeName);
+
+        ffListAdd(&table.procs);
+        memmove(FF_LIST_GET(FFProcInfo*, table.procs, index + 1), FF_LIST_GET(FFProcInfo*, table.procs, index),
+            (table.procs.length - 1 - index) * sizeof(FFProcInfo*));
+        *FF_LIST_GET(FFProcInfo*, table.procs, index) = proc;
+    }
+
+    FFProcInfoField missing = (FFProcInfoField) (fields & ~(proc->loaded | proc->failed));
+    if (missing)
+        loadFields(proc, missing);
+
+    bool ok = (proc->loaded & fields) == fields;
+    ffThreadMutexUnlock(&table.mutex);
+    return ok ? proc : NULL;
+}
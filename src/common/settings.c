@@ -49,35 +49,37 @@ typedef struct GSettingsData
     FF_LIBRARY_SYMBOL(g_settings_schema_source_get_default)
     GSettingsSchemaSource* schemaSource;
     GVariantGetters variantGetters;
-
-    bool inited;
 } GSettingsData;
 
+static void loadGSettingsData(GSettingsData* data)
+{
+    FF_LIBRARY_LOAD(libgsettings, , "libgio-2.0" FF_LIBRARY_EXTENSION, 1);
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libgsettings, data, g_settings_schema_source_lookup, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libgsettings, data, g_settings_schema_has_key, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libgsettings, data, g_settings_new_full, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libgsettings, data, g_settings_get_value, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libgsettings, data, g_settings_get_user_value, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libgsettings, data, g_settings_get_default_value, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libgsettings, data, g_settings_schema_source_get_default, )
+
+    FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data->variantGetters, g_variant_dup_string, )
+    FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data->variantGetters, g_variant_get_boolean, )
+    FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data->variantGetters, g_variant_get_int32, )
+    FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data->variantGetters, g_variant_unref, );
+
+    data->schemaSource = data->ffg_settings_schema_source_get_default();
+    if (data->schemaSource)
+        libgsettings = NULL;
+}
+
 static const GSettingsData* getGSettingsData(void)
 {
     static GSettingsData data;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+
+    FF_ONCE(&once)
+        loadGSettingsData(&data);
 
-    if (!data.inited)
-    {
-        data.inited = true;
-        FF_LIBRARY_LOAD(libgsettings, NULL, "libgio-2.0" FF_LIBRARY_EXTENSION, 1);
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data, g_settings_schema_source_lookup, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data, g_settings_schema_has_key, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data, g_settings_new_full, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data, g_settings_get_value, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data, g_settings_get_user_value, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data, g_settings_get_default_value, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data, g_settings_schema_source_get_default, NULL)
-
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data.variantGetters, g_variant_dup_string, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data.variantGetters, g_variant_get_boolean, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data.variantGetters, g_variant_get_int32, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libgsettings, data.variantGetters, g_variant_unref, NULL);
-
-        data.schemaSource = data.ffg_settings_schema_source_get_default();
-        if (data.schemaSource)
-            libgsettings = NULL;
-    }
     if(!data.schemaSource)
         return NULL;
 
@@ -129,30 +131,31 @@ typedef struct DConfData
     FF_LIBRARY_SYMBOL(dconf_client_new)
     GVariantGetters variantGetters;
     DConfClient* client;
-
-    bool inited;
 } DConfData;
 
+static void loadDConfData(DConfData* data)
+{
+    FF_LIBRARY_LOAD(libdconf, , "libdconf" FF_LIBRARY_EXTENSION, 2);
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libdconf, data, dconf_client_read_full, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libdconf, data, dconf_client_new, )
+    FF_LIBRARY_LOAD_SYMBOL_VAR(libdconf, data->variantGetters, g_variant_dup_string, )
+    FF_LIBRARY_LOAD_SYMBOL_VAR(libdconf, data->variantGetters, g_variant_get_boolean, )
+    FF_LIBRARY_LOAD_SYMBOL_VAR(libdconf, data->variantGetters, g_variant_get_int32, )
+    FF_LIBRARY_LOAD_SYMBOL_VAR(libdconf, data->variantGetters, g_variant_unref, )
+
+    data->client = data->ffdconf_client_new();
+    if (data->client)
+        libdconf = NULL;
+}
+
 static const DConfData* getDConfData(void)
 {
     static DConfData data;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+
+    FF_ONCE(&once)
+        loadDConfData(&data);
 
-    if (!data.inited)
-    {
-        data.inited = true;
-
-        FF_LIBRARY_LOAD(libdconf, NULL, "libdconf" FF_LIBRARY_EXTENSION, 2);
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libdconf, data, dconf_client_read_full, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libdconf, data, dconf_client_new, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libdconf, data.variantGetters, g_variant_dup_string, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libdconf, data.variantGetters, g_variant_get_boolean, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libdconf, data.variantGetters, g_variant_get_int32, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libdconf, data.variantGetters, g_variant_unref, NULL)
-
-        data.client = data.ffdconf_client_new();
-        if (data.client)
-            libdconf = NULL;
-    }
     if(!data.client)
         return NULL;
 
@@ -207,30 +210,31 @@ typedef struct XFConfData
     FF_LIBRARY_SYMBOL(xfconf_channel_get_bool)
     FF_LIBRARY_SYMBOL(xfconf_channel_get_int)
     FF_LIBRARY_SYMBOL(xfconf_init)
-
-    bool inited;
 } XFConfData;
 
+static void loadXFConfData(XFConfData* data)
+{
+    FF_LIBRARY_LOAD(libxfconf, , "libxfconf-0" FF_LIBRARY_EXTENSION, 4);
+
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libxfconf, data, xfconf_channel_get, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libxfconf, data, xfconf_channel_has_property, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libxfconf, data, xfconf_channel_get_string, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libxfconf, data, xfconf_channel_get_bool, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libxfconf, data, xfconf_channel_get_int, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libxfconf, data, xfconf_init, )
+    if(!data->ffxfconf_init(NULL))
+        data->ffxfconf_init = NULL;
+    else
+        libxfconf = NULL;
+}
+
 static const XFConfData* getXFConfData(void)
 {
     static XFConfData data;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
 
-    if (!data.inited)
-    {
-        data.inited = true;
-        FF_LIBRARY_LOAD(libxfconf, NULL, "libxfconf-0" FF_LIBRARY_EXTENSION, 4);
-
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libxfconf, data, xfconf_channel_get, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libxfconf, data, xfconf_channel_has_property, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libxfconf, data, xfconf_channel_get_string, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libxfconf, data, xfconf_channel_get_bool, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libxfconf, data, xfconf_channel_get_int, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libxfconf, data, xfconf_init, NULL)
-        if(!data.ffxfconf_init(NULL))
-            data.ffxfconf_init = NULL;
-        else
-            libxfconf = NULL;
-    }
+    FF_ONCE(&once)
+        loadXFConfData(&data);
 
     if(!data.ffxfconf_init)
         return NULL;
@@ -281,28 +285,29 @@ typedef struct SQLiteData
     FF_LIBRARY_SYMBOL(sqlite3_column_text)
     FF_LIBRARY_SYMBOL(sqlite3_finalize)
     FF_LIBRARY_SYMBOL(sqlite3_close)
-
-    bool inited;
 } SQLiteData;
 
+static void loadSQLiteData(SQLiteData* data)
+{
+    FF_LIBRARY_LOAD(libsqlite, , "libsqlite3" FF_LIBRARY_EXTENSION, 1);
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libsqlite, data, sqlite3_open_v2, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libsqlite, data, sqlite3_prepare_v2, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libsqlite, data, sqlite3_step, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libsqlite, data, sqlite3_data_count, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libsqlite, data, sqlite3_column_int, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libsqlite, data, sqlite3_column_text, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libsqlite, data, sqlite3_finalize, )
+    FF_LIBRARY_LOAD_SYMBOL_PTR(libsqlite, data, sqlite3_close, )
+    libsqlite = NULL;
+}
+
 static const SQLiteData* getSQLiteData(void)
 {
     static SQLiteData data;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
 
-    if (!data.inited)
-    {
-        data.inited = true;
-        FF_LIBRARY_LOAD(libsqlite, NULL, "libsqlite3" FF_LIBRARY_EXTENSION, 1);
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libsqlite, data, sqlite3_open_v2, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libsqlite, data, sqlite3_prepare_v2, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libsqlite, data, sqlite3_step, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libsqlite, data, sqlite3_data_count, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libsqlite, data, sqlite3_column_int, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libsqlite, data, sqlite3_column_text, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libsqlite, data, sqlite3_finalize, NULL)
-        FF_LIBRARY_LOAD_SYMBOL_VAR(libsqlite, data, sqlite3_close, NULL)
-        libsqlite = NULL;
-    }
+    FF_ONCE(&once)
+        loadSQLiteData(&data);
 
     if (!data.ffsqlite3_close)
         return NULL;
@@ -0,0 +1,271 @@
+#include "common/thread.h"
+
+#ifdef FF_HAVE_THREADS
+
+#include "common/time.h"
+
+#include <stdlib.h>
+
+#if _WIN32
+    #include <windows.h>
+#elif __linux__
+    #include <sched.h>
+#else
+    #include <unistd.h>
+#endif
+
+// Tasks are mostly blocked by I/O and child processes, so there are more workers than CPUs
+#define FF_THREAD_POOL_WORKERS_PER_CPU 2
+#define FF_THREAD_POOL_MIN_WORKERS 4
+#define FF_THREAD_POOL_MAX_WORKERS 8
+
+struct FFThreadFuture
+{
+    void (*func)(void* data);
+    void* data;
+    bool done; // Guarded by pool.mutex
+    bool released; // The waiter has given up. The worker frees the future. Guarded by pool.mutex
+};
+
+// Ring buffer. The owner takes tasks from the front, so that they run in submission order; others steal from the back
+typedef struct FFThreadDeque
+{
+    FFThreadMutex mutex;
+    FFThreadFuture** tasks;
+    uint32_t head;
+    uint32_t length;
+    uint32_t capacity;
+} FFThreadDeque;
+
+static struct
+{
+    FFThreadOnce once;
+    FFThreadMutex mutex;
+    FFThreadCond changed; // A task is queued or done
+    uint32_t queued; // Tasks that are queued and not claimed by any thread yet
+    uint32_t abandoned; // Running tasks whose future has been released
+    uint32_t nextDeque;
+    uint32_t workerCount;
+    FFThreadDeque deques[FF_THREAD_POOL_MAX_WORKERS];
+} pool = {
+    .once = FF_THREAD_ONCE_INITIALIZER,
+    .mutex = FF_THREAD_MUTEX_INITIALIZER,
+    .changed = FF_THREAD_COND_INITIALIZER,
+};
+
+static _Thread_local FFThreadDeque* ownDeque; // NULL if the current thread is not a worker
+
+static uint32_t getAvailableCpuCount(void)
+{
+    #if _WIN32
+        DWORD_PTR processMask, systemMask;
+        if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+            return (uint32_t) __builtin_popcountll((unsigned long long) processMask);
+        return 1;
+    #elif __linux__
+        cpu_set_t set;
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            return (uint32_t) CPU_COUNT(&set);
+        return 1;
+    #else
+        long count = sysconf(_SC_NPROCESSORS_ONLN);
+        return count > 0 ? (uint32_t) count : 1;
+    #endif
+}
+
+static void dequePush(FFThreadDeque* deque, FFThreadFuture* task)
+{
+    ffThreadMutexLock(&deque->mutex);
+    if (deque->length == deque->capacity)
+    {
+        uint32_t capacity = deque->capacity == 0 ? 16 : deque->capacity * 2;
+        FFThreadFuture** tasks = malloc(capacity * sizeof(*tasks));
+        for (uint32_t i = 0; i < deque->length; ++i)
+            tasks[i] = deque->tasks[(deque->head + i) % deque->capacity];
+        free(deque->tasks);
+        deque->tasks = tasks;
+        deque->capacity = capacity;
+        deque->head = 0;
+    }
+    deque->tasks[(deque->head + deque->length++) % deque->capacity] = task;
+    ffThreadMutexUnlock(&deque->mutex);
+}
+
+static FFThreadFuture* dequePop(FFThreadDeque* deque, bool steal)
+{
+    FFThreadFuture* task = NULL;
+    ffThreadMutexLock(&deque->mutex);
+    if (deque->length > 0)
+    {
+        if (steal)
+            task = deque->tasks[(deque->head + deque->length - 1) % deque->capacity];
+        else
+        {
+            task = deque->tasks[deque->head];
+            deque->head = (deque->head + 1) % deque->capacity;
+        }
+        --deque->length;
+    }
+    ffThreadMutexUnlock(&deque->mutex);
+    return task;
+}
+
+// Must be called after claiming a task by decreasing `pool.queued`, which guarantees that one can be found
+static FFThreadFuture* takeTask(void)
+{
+    while (true)
+    {
+        if (ownDeque)
+        {
+            FFThreadFuture* task = dequePop(ownDeque, false);
+            if (task) return task;
+        }
+
+        for (uint32_t i = 0; i < pool.workerCount; ++i)
+        {
+            FFThreadDeque* deque = &pool.deques[i];
+            if (deque == ownDeque) continue;
+            FFThreadFuture* task = dequePop(deque, true);
+            if (task) return task;
+        }
+    }
+}
+
+static void runTask(FFThreadFuture* task)
+{
+    task->func(task->data);
+
+    ffThreadMutexLock(&pool.mutex);
+    if (task->released)
+    {
+        --pool.abandoned;
+        free(task);
+    }
+    else
+        task->done = true;
+    ffThreadCondBroadcast(&pool.changed);
+    ffThreadMutexUnlock(&pool.mutex);
+}
+
+static void workerLoop(FFThreadDeque* deque)
+{
+    ownDeque = deque;
+
+    ffThreadMutexLock(&pool.mutex);
+    while (true)
+    {
+        if (pool.queued == 0)
+        {
+            ffThreadCondWait(&pool.changed, &pool.mutex);
+            continue;
+        }
+
+        --pool.queued;
+        ffThreadMutexUnlock(&pool.mutex);
+        runTask(takeTask());
+        ffThreadMutexLock(&pool.mutex);
+    }
+}
+
+FF_THREAD_ENTRY_DECL_WRAPPER(workerLoop, FFThreadDeque*)
+
+static void startPool(void)
+{
+    uint32_t count = getAvailableCpuCount() * FF_THREAD_POOL_WORKERS_PER_CPU;
+    if (count < FF_THREAD_POOL_MIN_WORKERS)
+        count = FF_THREAD_POOL_MIN_WORKERS;
+    else if (count > FF_THREAD_POOL_MAX_WORKERS)
+        count = FF_THREAD_POOL_MAX_WORKERS;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        FFThreadDeque* deque = &pool.deques[pool.workerCount];
+        *deque = (FFThreadDeque) { .mutex = FF_THREAD_MUTEX_INITIALIZER };
+
+        // Workers run until the process exits
+        FFThreadType thread = ffThreadCreate(workerLoopThreadMain, deque);
+        if (!thread) break;
+        ffThreadDetach(thread);
+        ++pool.workerCount;
+    }
+}
+
+FFThreadFuture* ffThreadPoolSubmit(void (*func)(void* data), void* data)
+{
+    FF_ONCE(&pool.once)
+        startPool();
+
+    if (pool.workerCount == 0)
+        return NULL;
+
+    FFThreadFuture* task = malloc(sizeof(*task));
+    *task = (FFThreadFuture) { .func = func, .data = data };
+
+    FFThreadDeque* deque = ownDeque;
+    if (!deque)
+        deque = &pool.deques[__atomic_fetch_add(&pool.nextDeque, 1, __ATOMIC_RELAXED) % pool.workerCount];
+    dequePush(deque, task);
+
+    ffThreadMutexLock(&pool.mutex);
+    ++pool.queued;
+    ffThreadCondBroadcast(&pool.changed);
+    ffThreadMutexUnlock(&pool.mutex);
+    return task;
+}
+
+bool ffThreadFutureIsDone(FFThreadFuture* future)
+{
+    ffThreadMutexLock(&pool.mutex);
+    bool done = future->done;
+    ffThreadMutexUnlock(&pool.mutex);
+    return done;
+}
+
+bool ffThreadFutureWait(FFThreadFuture* future, uint32_t timeout)
+{
+    double deadline = ffTimeGetTick() + timeout;
+
+    ffThreadMutexLock(&pool.mutex);
+    while (!future->done)
+    {
+        // A worker waiting for another task runs queued tasks meanwhile, so that the pool can't run out of workers
+        if (ownDeque && pool.queued > 0)
+        {
+            --pool.queued;
+            ffThreadMutexUnlock(&pool.mutex);
+            runTask(takeTask());
+            ffThreadMutexLock(&pool.mutex);
+        }
+        else if (timeout == 0)
+            ffThreadCondWait(&pool.changed, &pool.mutex);
+        else
+        {
+            double now = ffTimeGetTick();
+            if (now >= deadline)
+                break;
+            ffThreadCondTimedWait(&pool.changed, &pool.mutex, (uint32_t) (deadline - now) + 1);
+        }
+    }
+
+    bool done = future->done;
+    if (!done)
+    {
+        future->released = true;
+        ++pool.abandoned;
+    }
+    ffThreadMutexUnlock(&pool.mutex);
+
+    if (done)
+        free(future);
+    return done;
+}
+
+bool ffThreadPoolHasAbandonedTasks(void)
+{
+    ffThreadMutexLock(&pool.mutex);
+    bool result = pool.abandoned > 0;
+    ffThreadMutexUnlock(&pool.mutex);
+    return result;
+}
+
+#endif
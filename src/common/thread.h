@@ -9,10 +9,16 @@
         #include <process.h>
         #include <processthreadsapi.h>
         #define FF_THREAD_MUTEX_INITIALIZER SRWLOCK_INIT
+        #define FF_THREAD_COND_INITIALIZER CONDITION_VARIABLE_INIT
         typedef SRWLOCK FFThreadMutex;
+        typedef CONDITION_VARIABLE FFThreadCond;
         typedef HANDLE FFThreadType;
         static inline void ffThreadMutexLock(FFThreadMutex* mutex) { AcquireSRWLockExclusive(mutex); }
         static inline void ffThreadMutexUnlock(FFThreadMutex* mutex) { ReleaseSRWLockExclusive(mutex); }
+        static inline void ffThreadCondWait(FFThreadCond* cond, FFThreadMutex* mutex) { SleepConditionVariableSRW(cond, mutex, INFINITE, 0); }
+        static inline bool ffThreadCondTimedWait(FFThreadCond* cond, FFThreadMutex* mutex, uint32_t timeout) { return SleepConditionVariableSRW(cond, mutex, timeout, 0); }
+        static inline void ffThreadCondSignal(FFThreadCond* cond) { WakeConditionVariable(cond); }
+        static inline void ffThreadCondBroadcast(FFThreadCond* cond) { WakeAllConditionVariable(cond); }
         static inline FFThreadType ffThreadCreate(unsigned (__stdcall* func)(void*), void* data) {
             return (FFThreadType)_beginthreadex(NULL, 0, func, data, 0, NULL);
         }
@@ -33,22 +39,35 @@
     #else
         #include <pthread.h>
         #include <signal.h>
+        #include <time.h>
         #if FF_HAVE_PTHREAD_NP
             #include <pthread_np.h>
         #endif
         typedef pthread_t FFThreadType;
-        #if __APPLE__
-            #include <os/lock.h>
-            #define FF_THREAD_MUTEX_INITIALIZER OS_UNFAIR_LOCK_INIT
-            typedef os_unfair_lock FFThreadMutex;
-            static inline void ffThreadMutexLock(os_unfair_lock* mutex) { os_unfair_lock_lock(mutex); }
-            static inline void ffThreadMutexUnlock(os_unfair_lock* mutex) { os_unfair_lock_unlock(mutex); }
-        #else
-            #define FF_THREAD_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
-            typedef pthread_mutex_t FFThreadMutex;
-            static inline void ffThreadMutexLock(FFThreadMutex* mutex) { pthread_mutex_lock(mutex); }
-            static inline void ffThreadMutexUnlock(FFThreadMutex* mutex) { pthread_mutex_unlock(mutex); }
-        #endif
+        // os_unfair_lock can't be used with condition variables, so pthread mutex is used on macOS too
+        #define FF_THREAD_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+        #define FF_THREAD_COND_INITIALIZER PTHREAD_COND_INITIALIZER
+        typedef pthread_mutex_t FFThreadMutex;
+        typedef pthread_cond_t FFThreadCond;
+        static inline void ffThreadMutexLock(FFThreadMutex* mutex) { pthread_mutex_lock(mutex); }
+        static inline void ffThreadMutexUnlock(FFThreadMutex* mutex) { pthread_mutex_unlock(mutex); }
+        static inline void ffThreadCondWait(FFThreadCond* cond, FFThreadMutex* mutex) { pthread_cond_wait(cond, mutex); }
+        // Returns false on timeout (ms)
+        static inline bool ffThreadCondTimedWait(FFThreadCond* cond, FFThreadMutex* mutex, uint32_t timeout)
+        {
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            ts.tv_sec += timeout / 1000;
+            ts.tv_nsec += (long) (timeout % 1000) * 1000000;
+            if (ts.tv_nsec >= 1000000000)
+            {
+                ++ts.tv_sec;
+                ts.tv_nsec -= 1000000000;
+            }
+            return pthread_cond_timedwait(cond, mutex, &ts) == 0;
+        }
+        static inline void ffThreadCondSignal(FFThreadCond* cond) { pthread_cond_signal(cond); }
+        static inline void ffThreadCondBroadcast(FFThreadCond* cond) { pthread_cond_broadcast(cond); }
         static inline FFThreadType ffThreadCreate(void* (* func)(void*), void* data) {
             FFThreadType newThread = 0;
             pthread_create(&newThread, NULL, func, data);
@@ -87,3 +106,53 @@
     static inline void ffThreadMutexUnlock(FFThreadMutex* mutex) { FF_UNUSED(mutex) }
     #define FF_THREAD_ENTRY_DECL_WRAPPER(fn, paramType)
 #endif //FF_HAVE_THREADS
+
+typedef struct FFThreadOnce
+{
+    FFThreadMutex mutex;
+    bool done;
+} FFThreadOnce;
+#define FF_THREAD_ONCE_INITIALIZER { FF_THREAD_MUTEX_INITIALIZER, false }
+
+// Returns true with `once` locked if the caller should run the initialization, which must be followed by `ffThreadOnceEnd`.
+// Returns false if the initialization has finished, waiting for it if another thread is running it
+static inline bool ffThreadOnceBegin(FFThreadOnce* once)
+{
+    if (__atomic_load_n(&once->done, __ATOMIC_ACQUIRE))
+        return false;
+
+    ffThreadMutexLock(&once->mutex);
+    if (once->done)
+    {
+        ffThreadMutexUnlock(&once->mutex);
+        return false;
+    }
+    return true;
+}
+
+static inline void ffThreadOnceEnd(FFThreadOnce* once)
+{
+    __atomic_store_n(&once->done, true, __ATOMIC_RELEASE);
+    ffThreadMutexUnlock(&once->mutex);
+}
+
+// Runs the following statement only once. Concurrent callers wait until it has finished.
+// Don't `return`, `break` or `goto` out of the statement, or `once` will be locked forever
+#define FF_ONCE(once) for (bool ffOnceRun = ffThreadOnceBegin(once); ffOnceRun; ffOnceRun = false, ffThreadOnceEnd(once))
+
+#ifdef FF_HAVE_THREADS
+typedef struct FFThreadFuture FFThreadFuture;
+
+// Runs `func(data)` on the shared worker pool, which is started on first use and sized from the CPUs the process may run on.
+// Returns NULL if no worker can be started. The returned future must be passed to `ffThreadFutureWait` exactly once
+FFThreadFuture* ffThreadPoolSubmit(void (*func)(void* data), void* data);
+
+bool ffThreadFutureIsDone(FFThreadFuture* future);
+
+// Waits at most `timeout` ms (0 for no timeout) for the task to finish, and releases the future.
+// Returns false on timeout. The task keeps running then, and must not use anything owned by the caller anymore
+bool ffThreadFutureWait(FFThreadFuture* future, uint32_t timeout);
+
+// Returns true if tasks whose futures timed out may still be running, in which case global state must not be destroyed
+bool ffThreadPoolHasAbandonedTasks(void);
+#endif
@@ -2,32 +2,27 @@
 #include "common/io/io.h"
 #include "util/stringUtils.h"
 
-static const char* parseCpuCacheIndex(FFstrbuf* path, FFCPUCacheResult* result, FFstrbuf* buffer, FFstrbuf* added)
+enum { FF_CACHE_LEVEL, FF_CACHE_SIZE, FF_CACHE_TYPE, FF_CACHE_LINE_SIZE, FF_CACHE_SHARED_CPU_LIST, FF_CACHE_FILE_COUNT };
+
+static const char* parseCpuCacheIndexData(FFCPUCacheResult* result, FFReadFileBatchItem* items, FFstrbuf* added)
 {
-    uint32_t baseLen = path->length;
-    ffStrbufAppendS(path, "/level");
-    if (!ffReadFileBuffer(path->chars, buffer))
+    if (!items[FF_CACHE_LEVEL].success)
         return "ffReadFileBuffer(\"/sys/devices/system/cpu/cpuX/cache/indexX/level\") == NULL";
 
-    uint32_t level = (uint32_t) ffStrbufToUInt(buffer, 0);
+    uint32_t level = (uint32_t) ffStrbufToUInt(items[FF_CACHE_LEVEL].buffer, 0);
     if (level < 1 || level > 4) return "level < 1 || level > 4";
 
-    ffStrbufSubstrBefore(path, baseLen);
-    ffStrbufAppendS(path, "/size");
-    if (!ffReadFileBuffer(path->chars, buffer))
+    if (!items[FF_CACHE_SIZE].success)
         return "ffReadFileBuffer(\"/sys/devices/system/cpu/cpuX/cache/indexX/size\") == NULL";
 
-    uint32_t sizeKb = (uint32_t) ffStrbufToUInt(buffer, 0);
+    uint32_t sizeKb = (uint32_t) ffStrbufToUInt(items[FF_CACHE_SIZE].buffer, 0);
     if (sizeKb == 0) return "size == 0";
 
-    ffStrbufSubstrBefore(path, baseLen);
-    ffStrbufAppendS(path, "/type");
-    if (!ffReadFileBuffer(path->chars, buffer))
+    if (!items[FF_CACHE_TYPE].success)
         return "ffReadFileBuffer(\"/sys/devices/system/cpu/cpuX/cache/indexX/type\") == NULL";
-    ffStrbufTrimRightSpace(buffer);
 
     FFCPUCacheType cacheType = 0;
-    switch (buffer->chars[0])
+    switch (items[FF_CACHE_TYPE].buffer->chars[0])
     {
         case 'I': cacheType = FF_CPU_CACHE_TYPE_INSTRUCTION; break;
         case 'D': cacheType = FF_CPU_CACHE_TYPE_DATA; break;
@@ -37,15 +32,12 @@ static const char* parseCpuCacheIndex(FFstrbuf* path, FFCPUCacheResult* result,
     }
 
     uint32_t lineSize = 0;
-    ffStrbufSubstrBefore(path, baseLen);
-    ffStrbufAppendS(path, "/coherency_line_size");
-    if (ffReadFileBuffer(path->chars, buffer))
-        lineSize = (uint32_t) ffStrbufToUInt(buffer, 0);
-
-    ffStrbufSubstrBefore(path, baseLen);
-    ffStrbufAppendS(path, "/shared_cpu_list");
-    if (!ffReadFileBuffer(path->chars, buffer))
+    if (items[FF_CACHE_LINE_SIZE].success)
+        lineSize = (uint32_t) ffStrbufToUInt(items[FF_CACHE_LINE_SIZE].buffer, 0);
+
+    if (!items[FF_CACHE_SHARED_CPU_LIST].success)
         return "ffReadFileBuffer(\"/sys/devices/system/cpu/cpuX/cache/indexX/shared_cpu_list\") == NULL";
+    FFstrbuf* buffer = items[FF_CACHE_SHARED_CPU_LIST].buffer;
     ffStrbufTrimRightSpace(buffer);
 
     // deduplicate shared caches
@@ -56,10 +48,31 @@ static const char* parseCpuCacheIndex(FFstrbuf* path, FFCPUCacheResult* result,
     return NULL;
 }
 
-static const char* parseCpuCache(FFstrbuf* path, FFCPUCacheResult* result, FFstrbuf* buffer, FFstrbuf* added)
+static const char* parseCpuCacheIndex(int dfd, const char* indexName, FFCPUCacheResult* result, FFstrbuf* buffers, FFstrbuf* added)
+{
+    static const char* const fileNames[] = {
+        [FF_CACHE_LEVEL] = "level",
+        [FF_CACHE_SIZE] = "size",
+        [FF_CACHE_TYPE] = "type",
+        [FF_CACHE_LINE_SIZE] = "coherency_line_size",
+        [FF_CACHE_SHARED_CPU_LIST] = "shared_cpu_list",
+    };
+
+    char paths[FF_CACHE_FILE_COUNT][64];
+    FFReadFileBatchItem items[FF_CACHE_FILE_COUNT];
+    for (uint32_t i = 0; i < FF_CACHE_FILE_COUNT; ++i)
+    {
+        snprintf(paths[i], sizeof(paths[i]), "%s/%s", indexName, fileNames[i]);
+        items[i] = (FFReadFileBatchItem) { .dfd = dfd, .fileName = paths[i], .buffer = &buffers[i] };
+    }
+    ffReadFileBatch(items, FF_CACHE_FILE_COUNT);
+
+    return parseCpuCacheIndexData(result, items, added);
+}
+
+static const char* parseCpuCache(FFstrbuf* path, FFCPUCacheResult* result, FFstrbuf* buffers, FFstrbuf* added)
 {
     ffStrbufAppendS(path, "/cache/");
-    uint32_t baseLen = path->length;
     FF_AUTO_CLOSE_DIR DIR* pathCacheDir = opendir(path->chars);
     if (!pathCacheDir)
         return "opendir(\"/sys/devices/system/cpu/cpuX/cache/\") == NULL";
@@ -70,10 +83,8 @@ static const char* parseCpuCache(FFstrbuf* path, FFCPUCacheResult* result, FFstr
         if (!ffStrStartsWith(pathCacheEntry->d_name, "index")
             || !ffCharIsDigit(pathCacheEntry->d_name[strlen("index")])) continue;
 
-        ffStrbufAppendS(path, pathCacheEntry->d_name);
-        const char* error = parseCpuCacheIndex(path, result, buffer, added);
+        const char* error = parseCpuCacheIndex(dirfd(pathCacheDir), pathCacheEntry->d_name, result, buffers, added);
         if (error) return error;
-        ffStrbufSubstrBefore(path, baseLen);
     }
 
     return NULL;
@@ -88,9 +99,12 @@ const char* ffDetectCPUCache(FFCPUCacheResult* result)
     if (!pathCpuDir)
         return "opendir(\"/sys/devices/system/cpu/\") == NULL";
 
-    FF_STRBUF_AUTO_DESTROY buffer = ffStrbufCreate();
+    FFstrbuf buffers[FF_CACHE_FILE_COUNT];
+    for (uint32_t i = 0; i < FF_CACHE_FILE_COUNT; ++i)
+        ffStrbufInit(&buffers[i]);
     FF_STRBUF_AUTO_DESTROY added = ffStrbufCreate();
 
+    const char* error = NULL;
     struct dirent* pathCpuEntry;
     while ((pathCpuEntry = readdir(pathCpuDir)) != NULL)
     {
@@ -98,9 +112,12 @@ const char* ffDetectCPUCache(FFCPUCacheResult* result)
             !ffCharIsDigit(pathCpuEntry->d_name[strlen("cpu")])) continue;
 
         ffStrbufAppendS(&path, pathCpuEntry->d_name);
-        const char* error = parseCpuCache(&path, result, &buffer, &added);
-        if (error) return error;
+        error = parseCpuCache(&path, result, buffers, &added);
+        if (error) break;
         ffStrbufSubstrBefore(&path, baseLen);
     }
-    return NULL;
+
+    for (uint32_t i = 0; i < FF_CACHE_FILE_COUNT; ++i)
+        ffStrbufDestroy(&buffers[i]);
+    return error;
 }
@@ -6,9 +6,10 @@
 
 static FFlist cpuTimes1;
 
-void ffPrepareCPUUsage(void)
+void ffPrepareCPUUsage(FF_MAYBE_UNUSED FFCPUUsageOptions* options)
 {
-    assert(cpuTimes1.elementSize == 0);
+    if (cpuTimes1.elementSize != 0) return;
+
     ffListInit(&cpuTimes1, sizeof(FFCpuUsageInfo));
     ffGetCpuUsageInfo(&cpuTimes1);
 }
@@ -1,5 +1,6 @@
 #include "de.h"
 
+#include "common/cache.h"
 #include "common/dbus.h"
 #include "common/io/io.h"
 #include "common/library.h"
@@ -32,7 +33,7 @@ static void getKDE(FFstrbuf* result, FFDEOptions* options)
     if(result->length == 0)
         ffParsePropFileData("wayland-sessions/plasmawayland5.desktop", "X-KDE-PluginInfo-Version =", result);
 
-    if(result->length == 0 && options->slowVersionDetection)
+    if(result->length == 0 && options->slowVersionDetection && !ffCacheGetExeVersion("plasmashell", result))
     {
         if (ffProcessAppendStdOut(result, (char* const[]){
             "plasmashell",
@@ -40,6 +41,8 @@ static void getKDE(FFstrbuf* result, FFDEOptions* options)
             NULL
         }) == NULL) // plasmashell 5.27.5
             ffStrbufSubstrAfterLastC(result, ' ');
+
+        ffCacheSetExeVersion("plasmashell", result);
     }
 }
 
@@ -61,7 +64,7 @@ static void getGnome(FFstrbuf* result, FF_MAYBE_UNUSED FFDEOptions* options)
 {
     getGnomeByDbus(result);
 
-    if (result->length == 0 && options->slowVersionDetection)
+    if (result->length == 0 && options->slowVersionDetection && !ffCacheGetExeVersion("gnome-shell", result))
     {
         if (ffProcessAppendStdOut(result, (char* const[]){
             "gnome-shell",
@@ -69,6 +72,8 @@ static void getGnome(FFstrbuf* result, FF_MAYBE_UNUSED FFDEOptions* options)
             NULL
         }) == NULL) // GNOME Shell 44.1
             ffStrbufSubstrAfterLastC(result, ' ');
+
+        ffCacheSetExeVersion("gnome-shell", result);
     }
 }
 
@@ -79,7 +84,7 @@ static void getCinnamon(FFstrbuf* result, FF_MAYBE_UNUSED FFDEOptions* options)
     if (result->length == 0)
         ffParsePropFileData("applications/cinnamon.desktop", "X-GNOME-Bugzilla-Version =", result);
 
-    if (result->length == 0 && options->slowVersionDetection)
+    if (result->length == 0 && options->slowVersionDetection && !ffCacheGetExeVersion("cinnamon", result))
     {
         if (ffProcessAppendStdOut(result, (char* const[]){
             "cinnamon",
@@ -87,6 +92,8 @@ static void getCinnamon(FFstrbuf* result, FF_MAYBE_UNUSED FFDEOptions* options)
             NULL
         }) == NULL) // Cinnamon 6.2.2
             ffStrbufSubstrAfterLastC(result, ' ');
+
+        ffCacheSetExeVersion("cinnamon", result);
     }
 }
 
@@ -104,7 +111,7 @@ static void getMate(FFstrbuf* result, FFDEOptions* options)
 
     ffParseSemver(result, &major, &minor, &micro);
 
-    if(result->length == 0 && options->slowVersionDetection)
+    if(result->length == 0 && options->slowVersionDetection && !ffCacheGetExeVersion("mate-session", result))
     {
         ffProcessAppendStdOut(result, (char* const[]){
             "mate-session",
@@ -114,6 +121,8 @@ static void getMate(FFstrbuf* result, FFDEOptions* options)
 
         ffStrbufSubstrAfterFirstC(result, ' ');
         ffStrbufTrim(result, ' ');
+
+        ffCacheSetExeVersion("mate-session", result);
     }
 }
 
@@ -135,7 +144,7 @@ static void getXFCE4(FFstrbuf* result, FFDEOptions* options)
 {
     getXfce4ByLib(result);
 
-    if(result->length == 0 && options->slowVersionDetection)
+    if(result->length == 0 && options->slowVersionDetection && !ffCacheGetExeVersion("xfce4-session", result))
     {
         //This is somewhat slow
         ffProcessAppendStdOut(result, (char* const[]){
@@ -147,6 +156,8 @@ static void getXFCE4(FFstrbuf* result, FFDEOptions* options)
         ffStrbufSubstrBeforeFirstC(result, ')');
         ffStrbufSubstrAfterLastC(result, ' ');
         ffStrbufTrim(result, ' ');
+
+        ffCacheSetExeVersion("xfce4-session", result);
     }
 }
 
@@ -159,7 +170,7 @@ static void getLXQt(FFstrbuf* result, FFDEOptions* options)
     if(result->length == 0)
         ffParsePropFileData("cmake/lxqt/lxqt-config-version.cmake", "set ( PACKAGE_VERSION", result);
 
-    if(result->length == 0 && options->slowVersionDetection)
+    if(result->length == 0 && options->slowVersionDetection && !ffCacheGetExeVersion("lxqt-session", result))
     {
         //This is really, really, really slow. Thank you, LXQt developers
         ffProcessAppendStdOut(result, (char* const[]){
@@ -170,6 +181,8 @@ static void getLXQt(FFstrbuf* result, FFDEOptions* options)
 
         result->length = 0; //don't set '\0' byte
         ffParsePropLines(result->chars , "liblxqt", result);
+
+        ffCacheSetExeVersion("lxqt-session", result);
     }
 }
 
@@ -6,9 +6,10 @@
 #include <windows.h>
 #include <winioctl.h>
 
-static unsigned __stdcall testRemoteVolumeAccessible(void* mountpoint)
+#ifdef FF_HAVE_THREADS
+static void testRemoteVolumeAccessible(void* mountpoint)
 {
-    FF_AUTO_CLOSE_FD HANDLE handle = CreateFileW(
+    HANDLE handle = CreateFileW(
         (wchar_t*) mountpoint,
         READ_CONTROL,
         FILE_SHARE_READ,
@@ -16,8 +17,11 @@ static unsigned __stdcall testRemoteVolumeAccessible(void* mountpoint)
         OPEN_EXISTING,
         FILE_FLAG_BACKUP_SEMANTICS,
         NULL);
-    return 0;
+    if (handle != INVALID_HANDLE_VALUE)
+        CloseHandle(handle);
+    free(mountpoint); // A copy, because the task outlives the caller if it times out
 }
+#endif
 
 const char* ffDetectDisksImpl(FFDiskOptions* options, FFlist* disks)
 {
@@ -84,8 +88,11 @@ const char* ffDetectDisksImpl(FFDiskOptions* options, FFlist* disks)
         #ifdef FF_HAVE_THREADS
         if (driveType == DRIVE_REMOTE)
         {
-            FFThreadType thread = ffThreadCreate(testRemoteVolumeAccessible, mountpoint);
-            if (!ffThreadJoin(thread, 500))
+            wchar_t* copy = _wcsdup(mountpoint);
+            FFThreadFuture* future = ffThreadPoolSubmit(testRemoteVolumeAccessible, copy);
+            if (!future)
+                free(copy);
+            else if (!ffThreadFutureWait(future, 500))
                 continue;
         }
         #endif
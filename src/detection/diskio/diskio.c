@@ -9,7 +9,7 @@ static uint64_t time1;
 
 void ffPrepareDiskIO(FFDiskIOOptions* options)
 {
-    if (options->detectTotal) return;
+    if (options->detectTotal || time1 != 0) return;
 
     ffListInit(&ioCounters1, sizeof(FFDiskIOResult));
     ffDiskIOGetIoCounters(&ioCounters1, options);
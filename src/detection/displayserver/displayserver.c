@@ -1,4 +1,5 @@
 #include "displayserver.h"
+#include "common/thread.h"
 
 FFDisplayResult* ffdsAppendDisplay(
     FFDisplayServerResult* result,
@@ -54,7 +55,8 @@ void ffConnectDisplayServerImpl(FFDisplayServerResult* ds);
 const FFDisplayServerResult* ffConnectDisplayServer()
 {
     static FFDisplayServerResult result;
-    if (result.displays.elementSize == 0)
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+    FF_ONCE(&once)
     {
         ffStrbufInit(&result.wmProcessName);
         ffStrbufInit(&result.wmPrettyName);
@@ -21,6 +21,8 @@
 #elif __NetBSD__
     #include <sys/types.h>
     #include <sys/sysctl.h>
+#elif __linux__
+    #include "common/proctable.h"
 #endif
 
 static const char* parseEnv(void)
@@ -352,53 +354,31 @@ static const char* getFromProcesses(FFDisplayServerResult* result)
         }
     }
 #elif __linux__
-    FF_AUTO_CLOSE_DIR DIR* procdir = opendir("/proc");
-    if(procdir == NULL)
+    FF_LIST_AUTO_DESTROY pids = ffListCreate(sizeof(pid_t));
+    if (!ffProcTableGetPids(&pids))
         return "opendir(\"/proc\") failed";
 
-    FF_STRBUF_AUTO_DESTROY procPath = ffStrbufCreateA(64);
-    ffStrbufAppendS(&procPath, "/proc/");
-
-    uint32_t procPathLength = procPath.length;
-
-    FF_STRBUF_AUTO_DESTROY loginuid = ffStrbufCreate();
-    FF_STRBUF_AUTO_DESTROY processName = ffStrbufCreateA(256); //Some processes have large command lines (looking at you chrome)
-
-    struct dirent* dirent;
-    while((dirent = readdir(procdir)) != NULL)
+    FF_LIST_FOR_EACH(pid_t, pid, pids)
     {
-        //Match only folders starting with a number (the pid folders)
-        if(dirent->d_type != DT_DIR || !ffCharIsDigit(dirent->d_name[0]))
+        // Don't check for processes not owned by the current user.
+        // The owner is checked first, because it doesn't require reading a file
+        const FFProcInfo* proc = ffProcTableGet(*pid, FF_PROC_INFO_UID);
+        if (proc == NULL || proc->uid != userId)
             continue;
 
-        ffStrbufAppendS(&procPath, dirent->d_name);
-        uint32_t procFolderPathLength = procPath.length;
-
-        //Don't check for processes not owned by the current user.
-        ffStrbufAppendS(&procPath, "/loginuid");
-        ffReadFileBuffer(procPath.chars, &loginuid);
-        if(ffStrbufToUInt(&loginuid, (uint64_t) -1) != userId)
-        {
-            ffStrbufSubstrBefore(&procPath, procPathLength);
+        proc = ffProcTableGet(*pid, FF_PROC_INFO_LOGINUID);
+        if (proc == NULL || proc->loginuid != userId)
             continue;
-        }
-
-        ffStrbufSubstrBefore(&procPath, procFolderPathLength);
 
-        //We check the cmdline for the process name, because it is not trimmed.
-        ffStrbufAppendS(&procPath, "/cmdline");
-        ffReadFileBuffer(procPath.chars, &processName);
-        ffStrbufTrimRightSpace(&processName);
-        ffStrbufSubstrBeforeFirstC(&processName, '\0'); //Trim the arguments
-        ffStrbufSubstrAfterLastC(&processName, '/');
-
-        ffStrbufSubstrBefore(&procPath, procPathLength);
+        proc = ffProcTableGet(*pid, FF_PROC_INFO_EXE_NAME);
+        if (proc == NULL)
+            continue;
 
         if(result->dePrettyName.length == 0)
-            applyPrettyNameIfDE(result, processName.chars);
+            applyPrettyNameIfDE(result, proc->exeName.chars);
 
         if(result->wmPrettyName.length == 0)
-            applyNameIfWM(result, processName.chars);
+            applyNameIfWM(result, proc->exeName.chars);
 
         if(result->dePrettyName.length > 0 && result->wmPrettyName.length > 0)
             break;
@@ -1,4 +1,5 @@
 #include "editor.h"
+#include "common/cache.h"
 #include "common/processing.h"
 #include "common/library.h"
 #include "util/stringUtils.h"
@@ -37,6 +38,61 @@ static bool extractNanoVersionFromBinary(const char* str, FF_MAYBE_UNUSED uint32
     return false;
 }
 
+static void getEditorVersion(FFEditorResult* result)
+{
+    if (ffStrbufEqualS(&result->exe, "nvim"))
+        ffBinaryExtractStrings(result->path.chars, extractNvimVersionFromBinary, &result->version, (uint32_t) strlen("NVIM v0.0.0"));
+    else if (ffStrbufEqualS(&result->exe, "vim") || ffStrbufStartsWithS(&result->exe, "vim."))
+        ffBinaryExtractStrings(result->path.chars, extractVimVersionFromBinary, &result->version, (uint32_t) strlen("VIM - Vi IMproved 0.0"));
+    else if (ffStrbufEqualS(&result->exe, "nano"))
+        ffBinaryExtractStrings(result->path.chars, extractNanoVersionFromBinary, &result->version, (uint32_t) strlen("GNU nano 0.0"));
+
+    if (result->version.length > 0) return;
+
+    const char* param = NULL;
+    if (
+        ffStrbufEqualS(&result->exe, "nano") ||
+        ffStrbufEqualS(&result->exe, "vim") ||
+        ffStrbufStartsWithS(&result->exe, "vim.") || // vim.basic/vim.tiny
+        ffStrbufEqualS(&result->exe, "nvim") ||
+        ffStrbufEqualS(&result->exe, "micro") ||
+        ffStrbufEqualS(&result->exe, "emacs") ||
+        ffStrbufStartsWithS(&result->exe, "emacs-") || // emacs-29.3
+        ffStrbufEqualS(&result->exe, "hx") ||
+        ffStrbufEqualS(&result->exe, "code") ||
+        ffStrbufEqualS(&result->exe, "pluma") ||
+        ffStrbufEqualS(&result->exe, "sublime_text")
+    ) param = "--version";
+    else if (
+        ffStrbufEqualS(&result->exe, "kak") ||
+        ffStrbufEqualS(&result->exe, "pico")
+    ) param = "-version";
+    else if (
+        ffStrbufEqualS(&result->exe, "ne")
+    ) param = "-h";
+    else return;
+
+    ffProcessAppendStdOut(&result->version, (char* const[]){
+        result->path.chars,
+        (char*) param,
+        NULL,
+    });
+
+    if (result->version.length == 0)
+        return;
+
+    ffStrbufSubstrBeforeFirstC(&result->version, '\n');
+    const char* versionStart = strpbrk(result->version.chars, "0123456789");
+    if (versionStart != NULL) {
+        const char* versionEnd = strpbrk(versionStart, " \t\v\f\r");
+        if (versionEnd != NULL)
+            ffStrbufSubstrBefore(&result->version, (uint32_t)(versionEnd - result->version.chars));
+
+        if (versionStart != result->version.chars)
+            ffStrbufSubstrAfter(&result->version, (uint32_t)(versionStart - result->version.chars - 1));
+    }
+}
+
 const char* ffDetectEditor(FFEditorResult* result)
 {
     ffStrbufSetS(&result->name, getenv("VISUAL"));
@@ -94,56 +150,10 @@ const char* ffDetectEditor(FFEditorResult* result)
 
     if (!instance.config.general.detectVersion) return NULL;
 
-    if (ffStrbufEqualS(&result->exe, "nvim"))
-        ffBinaryExtractStrings(result->path.chars, extractNvimVersionFromBinary, &result->version, (uint32_t) strlen("NVIM v0.0.0"));
-    else if (ffStrbufEqualS(&result->exe, "vim") || ffStrbufStartsWithS(&result->exe, "vim."))
-        ffBinaryExtractStrings(result->path.chars, extractVimVersionFromBinary, &result->version, (uint32_t) strlen("VIM - Vi IMproved 0.0"));
-    else if (ffStrbufEqualS(&result->exe, "nano"))
-        ffBinaryExtractStrings(result->path.chars, extractNanoVersionFromBinary, &result->version, (uint32_t) strlen("GNU nano 0.0"));
-
-    if (result->version.length > 0) return NULL;
-
-    const char* param = NULL;
-    if (
-        ffStrbufEqualS(&result->exe, "nano") ||
-        ffStrbufEqualS(&result->exe, "vim") ||
-        ffStrbufStartsWithS(&result->exe, "vim.") || // vim.basic/vim.tiny
-        ffStrbufEqualS(&result->exe, "nvim") ||
-        ffStrbufEqualS(&result->exe, "micro") ||
-        ffStrbufEqualS(&result->exe, "emacs") ||
-        ffStrbufStartsWithS(&result->exe, "emacs-") || // emacs-29.3
-        ffStrbufEqualS(&result->exe, "hx") ||
-        ffStrbufEqualS(&result->exe, "code") ||
-        ffStrbufEqualS(&result->exe, "pluma") ||
-        ffStrbufEqualS(&result->exe, "sublime_text")
-    ) param = "--version";
-    else if (
-        ffStrbufEqualS(&result->exe, "kak") ||
-        ffStrbufEqualS(&result->exe, "pico")
-    ) param = "-version";
-    else if (
-        ffStrbufEqualS(&result->exe, "ne")
-    ) param = "-h";
-    else return NULL;
-
-    ffProcessAppendStdOut(&result->version, (char* const[]){
-        result->path.chars,
-        (char*) param,
-        NULL,
-    });
-
-    if (result->version.length == 0)
-        return NULL;
-
-    ffStrbufSubstrBeforeFirstC(&result->version, '\n');
-    const char* versionStart = strpbrk(result->version.chars, "0123456789");
-    if (versionStart != NULL) {
-        const char* versionEnd = strpbrk(versionStart, " \t\v\f\r");
-        if (versionEnd != NULL)
-            ffStrbufSubstrBefore(&result->version, (uint32_t)(versionEnd - result->version.chars));
-
-        if (versionStart != result->version.chars)
-            ffStrbufSubstrAfter(&result->version, (uint32_t)(versionStart - result->version.chars - 1));
+    if (!ffCacheGetExeVersion(result->path.chars, &result->version))
+    {
+        getEditorVersion(result);
+        ffCacheSetExeVersion(result->path.chars, &result->version);
     }
 
     return NULL;
@@ -1,6 +1,7 @@
 #include "gpu.h"
 #include "common/io/io.h"
 #include "common/properties.h"
+#include "common/thread.h"
 
 #include <stdlib.h>
 #ifdef __FreeBSD__
@@ -24,36 +25,42 @@
 #define FF_STR_INDIR(x) #x
 #define FF_STR(x) FF_STR_INDIR(x)
 
-static const FFstrbuf* loadPciIds()
+static void readPciIds(FFstrbuf* pciids)
 {
-    static FFstrbuf pciids;
-
-    if (pciids.chars) return &pciids;
-    ffStrbufInit(&pciids);
+    ffStrbufInit(pciids);
 
     #ifdef FF_CUSTOM_PCI_IDS_PATH
 
-        ffReadFileBuffer(FF_STR(FF_CUSTOM_PCI_IDS_PATH), &pciids);
+        ffReadFileBuffer(FF_STR(FF_CUSTOM_PCI_IDS_PATH), pciids);
 
     #else // FF_CUSTOM_PCI_IDS_PATH
 
         #if __linux__
-        ffReadFileBuffer(FASTFETCH_TARGET_DIR_USR "/share/hwdata/pci.ids", &pciids);
-        if (pciids.length == 0)
+        ffReadFileBuffer(FASTFETCH_TARGET_DIR_USR "/share/hwdata/pci.ids", pciids);
+        if (pciids->length == 0)
         {
-            ffReadFileBuffer(FASTFETCH_TARGET_DIR_USR "/share/misc/pci.ids", &pciids); // debian?
-            if (pciids.length == 0)
-                ffReadFileBuffer(FASTFETCH_TARGET_DIR_USR "/local/share/hwdata/pci.ids", &pciids);
+            ffReadFileBuffer(FASTFETCH_TARGET_DIR_USR "/share/misc/pci.ids", pciids); // debian?
+            if (pciids->length == 0)
+                ffReadFileBuffer(FASTFETCH_TARGET_DIR_USR "/local/share/hwdata/pci.ids", pciids);
         }
         #elif __FreeBSD__ || __OpenBSD__ || __NetBSD__
-        ffReadFileBuffer(_PATH_LOCALBASE "/share/pciids/pci.ids", &pciids);
+        ffReadFileBuffer(_PATH_LOCALBASE "/share/pciids/pci.ids", pciids);
         #elif __sun
-        ffReadFileBuffer(FASTFETCH_TARGET_DIR_ROOT "/usr/share/hwdata/pci.ids", &pciids);
+        ffReadFileBuffer(FASTFETCH_TARGET_DIR_ROOT "/usr/share/hwdata/pci.ids", pciids);
         #elif __HAIKU__
-        ffReadFileBuffer(FASTFETCH_TARGET_DIR_ROOT "/system/data/hwdata/pci.ids", &pciids);
+        ffReadFileBuffer(FASTFETCH_TARGET_DIR_ROOT "/system/data/hwdata/pci.ids", pciids);
         #endif
 
     #endif // FF_CUSTOM_PCI_IDS_PATH
+}
+
+static const FFstrbuf* loadPciIds()
+{
+    static FFstrbuf pciids;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+
+    FF_ONCE(&once)
+        readPciIds(&pciids);
 
     return &pciids;
 }
@@ -162,36 +162,36 @@ static void detectKvantum(FFQtResult* result)
     });
 }
 
-const FFQtResult* ffDetectQt(void)
+static void detectQt(FFQtResult* result)
 {
-    static FFQtResult result;
-
-    static bool init = false;
-    if(init)
-        return &result;
-    init = true;
-
-    ffStrbufInit(&result.widgetStyle);
-    ffStrbufInit(&result.colorScheme);
-    ffStrbufInit(&result.icons);
-    ffStrbufInit(&result.font);
-    ffStrbufInit(&result.wallpaper);
+    ffStrbufInit(&result->widgetStyle);
+    ffStrbufInit(&result->colorScheme);
+    ffStrbufInit(&result->icons);
+    ffStrbufInit(&result->font);
+    ffStrbufInit(&result->wallpaper);
 
     const FFDisplayServerResult* wmde = ffConnectDisplayServer();
     const char *qplatformtheme = getenv("QT_QPA_PLATFORMTHEME");
 
     if(ffStrbufIgnCaseEqualS(&wmde->dePrettyName, FF_DE_PRETTY_PLASMA))
-        detectPlasma(&result);
+        detectPlasma(result);
     else if(ffStrbufIgnCaseEqualS(&wmde->dePrettyName, FF_DE_PRETTY_LXQT))
-        detectLXQt(&result);
+        detectLXQt(result);
     else if(ffStrSet(qplatformtheme) && (ffStrEquals(qplatformtheme, "qt5ct") || ffStrEquals(qplatformtheme, "qt6ct")))
-        detectQtCt(qplatformtheme[2], &result);
+        detectQtCt(qplatformtheme[2], result);
 
-    if(ffStrbufEqualS(&result.widgetStyle, "kvantum") || ffStrbufEqualS(&result.widgetStyle, "kvantum-dark"))
+    if(ffStrbufEqualS(&result->widgetStyle, "kvantum") || ffStrbufEqualS(&result->widgetStyle, "kvantum-dark"))
     {
-        ffStrbufClear(&result.widgetStyle);
-        detectKvantum(&result);
+        ffStrbufClear(&result->widgetStyle);
+        detectKvantum(result);
     }
+}
 
+const FFQtResult* ffDetectQt(void)
+{
+    static FFQtResult result;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+    FF_ONCE(&once)
+        detectQt(&result);
     return &result;
 }
@@ -1,4 +1,5 @@
 #include "initsystem.h"
+#include "common/cache.h"
 #include "common/processing.h"
 #include "util/binary.h"
 #include "util/stringUtils.h"
@@ -16,6 +17,66 @@ FF_MAYBE_UNUSED static bool extractSystemdVersion(const char* str, uint32_t len,
     return false;
 }
 
+static void getInitSystemVersion(FF_MAYBE_UNUSED FFInitSystemResult* result)
+{
+    #if __linux__ && !__ANDROID__
+    if (ffStrbufEqualS(&result->name, "systemd"))
+    {
+        ffBinaryExtractStrings(result->exe.chars, extractSystemdVersion, &result->version, (uint32_t) strlen("systemd 0.0 running in x"));
+        if (result->version.length == 0)
+        {
+            if (ffProcessAppendStdOut(&result->version, (char* const[]) {
+                ffStrbufEndsWithS(&result->exe, "/systemd") ? result->exe.chars : "systemctl", // use exe path in case users have another systemd installed
+                "--version",
+                NULL,
+            }) == NULL && result->version.length)
+            {
+                uint32_t iStart = ffStrbufFirstIndexC(&result->version, '(');
+                if (iStart < result->version.length)
+                {
+                    uint32_t iEnd = ffStrbufNextIndexC(&result->version, iStart + 1, ')');
+                    ffStrbufSubstrBefore(&result->version, iEnd);
+                    ffStrbufSubstrAfter(&result->version, iStart);
+                }
+            }
+        }
+    }
+    else if (ffStrbufEqualS(&result->name, "dinit"))
+    {
+        if (ffProcessAppendStdOut(&result->version, (char* const[]) {
+            ffStrbufEndsWithS(&result->exe, "/dinit") ? result->exe.chars : "dinit",
+            "--version",
+            NULL,
+        }) == NULL && result->version.length)
+        {
+            // Dinit version 0.18.0.
+            ffStrbufSubstrBeforeFirstC(&result->version, '\n');
+            ffStrbufTrimRight(&result->version, '.');
+            ffStrbufSubstrAfterLastC(&result->version, ' ');
+        }
+    }
+    #elif __APPLE__
+    if (ffStrbufEqualS(&result->name, "launchd"))
+    {
+        if (ffProcessAppendStdOut(&result->version, (char* const[]) {
+            "/bin/launchctl",
+            "version",
+            NULL,
+        }) == NULL && result->version.length)
+        {
+            uint32_t iStart = ffStrbufFirstIndexS(&result->version, "Version ");
+            if (iStart < result->version.length)
+            {
+                iStart += (uint32_t) strlen("Version");
+                uint32_t iEnd = ffStrbufNextIndexC(&result->version, iStart + 1, ':');
+                ffStrbufSubstrBefore(&result->version, iEnd);
+                ffStrbufSubstrAfter(&result->version, iStart);
+            }
+        }
+    }
+    #endif
+}
+
 const char* ffDetectInitSystem(FFInitSystemResult* result)
 {
     const char* error = ffProcessGetBasicInfoLinux((int) result->pid, &result->name, NULL, NULL);
@@ -46,64 +107,10 @@ const char* ffDetectInitSystem(FFInitSystemResult* result)
         }
     }
 
-    if (instance.config.general.detectVersion)
+    if (instance.config.general.detectVersion && !ffCacheGetExeVersion(result->exe.chars, &result->version))
     {
-        #if __linux__ && !__ANDROID__
-        if (ffStrbufEqualS(&result->name, "systemd"))
-        {
-            ffBinaryExtractStrings(result->exe.chars, extractSystemdVersion, &result->version, (uint32_t) strlen("systemd 0.0 running in x"));
-            if (result->version.length == 0)
-            {
-                if (ffProcessAppendStdOut(&result->version, (char* const[]) {
-                    ffStrbufEndsWithS(&result->exe, "/systemd") ? result->exe.chars : "systemctl", // use exe path in case users have another systemd installed
-                    "--version",
-                    NULL,
-                }) == NULL && result->version.length)
-                {
-                    uint32_t iStart = ffStrbufFirstIndexC(&result->version, '(');
-                    if (iStart < result->version.length)
-                    {
-                        uint32_t iEnd = ffStrbufNextIndexC(&result->version, iStart + 1, ')');
-                        ffStrbufSubstrBefore(&result->version, iEnd);
-                        ffStrbufSubstrAfter(&result->version, iStart);
-                    }
-                }
-            }
-        }
-        else if (ffStrbufEqualS(&result->name, "dinit"))
-        {
-            if (ffProcessAppendStdOut(&result->version, (char* const[]) {
-                ffStrbufEndsWithS(&result->exe, "/dinit") ? result->exe.chars : "dinit",
-                "--version",
-                NULL,
-            }) == NULL && result->version.length)
-            {
-                // Dinit version 0.18.0.
-                ffStrbufSubstrBeforeFirstC(&result->version, '\n');
-                ffStrbufTrimRight(&result->version, '.');
-                ffStrbufSubstrAfterLastC(&result->version, ' ');
-            }
-        }
-        #elif __APPLE__
-        if (ffStrbufEqualS(&result->name, "launchd"))
-        {
-            if (ffProcessAppendStdOut(&result->version, (char* const[]) {
-                "/bin/launchctl",
-                "version",
-                NULL,
-            }) == NULL && result->version.length)
-            {
-                uint32_t iStart = ffStrbufFirstIndexS(&result->version, "Version ");
-                if (iStart < result->version.length)
-                {
-                    iStart += (uint32_t) strlen("Version");
-                    uint32_t iEnd = ffStrbufNextIndexC(&result->version, iStart + 1, ':');
-                    ffStrbufSubstrBefore(&result->version, iEnd);
-                    ffStrbufSubstrAfter(&result->version, iStart);
-                }
-            }
-        }
-        #endif
+        getInitSystemVersion(result);
+        ffCacheSetExeVersion(result->exe.chars, &result->version);
     }
 
     return NULL;
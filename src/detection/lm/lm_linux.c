@@ -1,4 +1,5 @@
 #include "lm.h"
+#include "common/cache.h"
 #include "common/properties.h"
 #include "common/dbus.h"
 #include "common/processing.h"
@@ -11,28 +12,45 @@
 
 static const char* getGdmVersion(FFstrbuf* version)
 {
-    const char* error = ffProcessAppendStdOut(version, (char* const[]) {
+    if (ffCacheGetExeVersion("gdm", version) || ffCacheGetExeVersion("gdm3", version))
+        return NULL;
+
+    // Distros ship either of them. Probe both at once
+    FF_STRBUF_AUTO_DESTROY gdm3Version = ffStrbufCreate();
+    FFProcessHandle handles[2];
+    ffProcessSpawn(&handles[0], version, (char* const[]) {
         "gdm",
         "--version",
         NULL
-    });
-    if (error || version->length == 0)
+    }, false);
+    ffProcessSpawn(&handles[1], &gdm3Version, (char* const[]) {
+        "gdm3",
+        "--version",
+        NULL
+    }, false);
+    ffProcessWaitAll(handles, ARRAY_SIZE(handles));
+
+    const char* exe = "gdm";
+    ffStrbufTrimRightSpace(version);
+    if (handles[0].error || version->length == 0)
     {
-        error = ffProcessAppendStdOut(version, (char* const[]) {
-            "gdm3",
-            "--version",
-            NULL
-        });
-        if (error || version->length == 0) return "Failed to get GDM version";
+        ffStrbufTrimRightSpace(&gdm3Version);
+        if (handles[1].error || gdm3Version.length == 0) return "Failed to get GDM version";
+        ffStrbufSet(version, &gdm3Version);
+        exe = "gdm3";
     }
 
     // GDM 44.1
     ffStrbufSubstrAfterFirstC(version, ' ');
+    ffCacheSetExeVersion(exe, version);
     return NULL;
 }
 
 static const char* getSshdVersion(FFstrbuf* version)
 {
+    if (ffCacheGetExeVersion("sshd", version))
+        return NULL;
+
     const char* error = ffProcessAppendStdErr(version, (char* const[]) {
         "sshd",
         "-V",
@@ -44,6 +62,7 @@ static const char* getSshdVersion(FFstrbuf* version)
     // OpenSSH_9.0p1, OpenSSL 3.0.9 30 May 2023...
     ffStrbufSubstrBeforeFirstC(version, ',');
     ffStrbufSubstrAfterFirstC(version, '_');
+    ffCacheSetExeVersion("sshd", version);
     return NULL;
 }
 
@@ -52,8 +71,14 @@ static const char* getSshdVersion(FFstrbuf* version)
 #include <stdlib.h>
 #include <zlib.h>
 
+#define FF_SDDM_MAN_PAGE_PATH FASTFETCH_TARGET_DIR_USR "/share/man/man1/sddm.1.gz"
+
 static const char* getSddmVersion(FFstrbuf* version)
 {
+    // The version is only found in the man page
+    if (ffCacheGetExeVersion(FF_SDDM_MAN_PAGE_PATH, version))
+        return NULL;
+
     FF_LIBRARY_LOAD(zlib, "dlopen libz failed", "libz" FF_LIBRARY_EXTENSION, 2)
     FF_LIBRARY_LOAD_SYMBOL_MESSAGE(zlib, gzopen)
     FF_LIBRARY_LOAD_SYMBOL_MESSAGE(zlib, gzread)
@@ -62,7 +87,7 @@ static const char* getSddmVersion(FFstrbuf* version)
     FF_LIBRARY_LOAD_SYMBOL_MESSAGE(zlib, gzrewind)
     FF_LIBRARY_LOAD_SYMBOL_MESSAGE(zlib, gzclose)
 
-    gzFile file = ffgzopen(FASTFETCH_TARGET_DIR_USR "/share/man/man1/sddm.1.gz", "rb");
+    gzFile file = ffgzopen(FF_SDDM_MAN_PAGE_PATH, "rb");
     if (file == Z_NULL)
         return "ffgzopen(\"/usr/share/man/man1/sddm.1.gz\", \"rb\") failed";
 
@@ -90,6 +115,7 @@ static const char* getSddmVersion(FFstrbuf* version)
     ffStrbufTrimRight(version, '"');
     ffStrbufSubstrAfterLastC(version, ' ');
 
+    ffCacheSetExeVersion(FF_SDDM_MAN_PAGE_PATH, version);
     return NULL;
 }
 #else
@@ -101,6 +127,9 @@ static const char* getSddmVersion(FF_MAYBE_UNUSED FFstrbuf* version)
 
 static const char* getXfwmVersion(FFstrbuf* version)
 {
+    if (ffCacheGetExeVersion("xfwm4", version))
+        return NULL;
+
     const char* error = ffProcessAppendStdOut(version, (char* const[]) {
         "xfwm4",
         "--version",
@@ -113,11 +142,15 @@ static const char* getXfwmVersion(FFstrbuf* version)
     ffStrbufSubstrAfterFirstS(version, "version ");
     ffStrbufSubstrBeforeFirstC(version, ' ');
 
+    ffCacheSetExeVersion("xfwm4", version);
     return NULL;
 }
 
 static const char* getLightdmVersion(FFstrbuf* version)
 {
+    if (ffCacheGetExeVersion("lightdm", version))
+        return NULL;
+
     const char* error = ffProcessAppendStdErr(version, (char* const[]) {
         "lightdm",
         "--version",
@@ -130,6 +163,7 @@ static const char* getLightdmVersion(FFstrbuf* version)
     ffStrbufSubstrAfterFirstC(version, ' ');
     ffStrbufTrimRight(version, '\n');
 
+    ffCacheSetExeVersion("lightdm", version);
     return NULL;
 }
 
@@ -1,12 +1,14 @@
 #include "media.h"
+#include "common/thread.h"
 
 void ffDetectMediaImpl(FFMediaResult* media);
 
 const FFMediaResult* ffDetectMedia(void)
 {
     static FFMediaResult result;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
 
-    if (result.error.chars == NULL)
+    FF_ONCE(&once)
     {
         ffStrbufInit(&result.error);
         ffStrbufInit(&result.playerId);
@@ -7,7 +7,7 @@ static uint64_t time1;
 
 void ffPrepareNetIO(FFNetIOOptions* options)
 {
-    if (options->detectTotal) return;
+    if (options->detectTotal || time1 != 0) return;
 
     ffListInit(&ioCounters1, sizeof(FFNetIOResult));
     ffNetIOGetIoCounters(&ioCounters1, options);
@@ -5,6 +5,7 @@
 #include "util/stringUtils.h"
 
 #include <net/if.h>
+#include <fcntl.h>
 
 static void getData(FFstrbuf* buffer, const char* ifName, bool isDefaultRoute, FFstrbuf* path, FFlist* result)
 {
@@ -13,51 +14,40 @@ static void getData(FFstrbuf* buffer, const char* ifName, bool isDefaultRoute, F
         return;
 
     FFNetIOResult* counters = (FFNetIOResult*) ffListAdd(result);
+    *counters = (FFNetIOResult) { .defaultRoute = isDefaultRoute };
     ffStrbufInitS(&counters->name, ifName);
-    counters->defaultRoute = isDefaultRoute;
-
-    ffStrbufSetF(path, "/sys/class/net/%s/statistics/", ifName);
-    uint32_t statLen = path->length;
-
-    ffStrbufAppendS(path, "rx_bytes");
-    if (ffReadFileBuffer(path->chars, buffer))
-        counters->rxBytes = ffStrbufToUInt(buffer, 0);
-    ffStrbufSubstrBefore(path, statLen);
-
-    ffStrbufAppendS(path, "tx_bytes");
-    if (ffReadFileBuffer(path->chars, buffer))
-        counters->txBytes = ffStrbufToUInt(buffer, 0);
-    ffStrbufSubstrBefore(path, statLen);
-
-    ffStrbufAppendS(path, "rx_packets");
-    if (ffReadFileBuffer(path->chars, buffer))
-        counters->rxPackets = ffStrbufToUInt(buffer, 0);
-    ffStrbufSubstrBefore(path, statLen);
-
-    ffStrbufAppendS(path, "tx_packets");
-    if (ffReadFileBuffer(path->chars, buffer))
-        counters->txPackets = ffStrbufToUInt(buffer, 0);
-    ffStrbufSubstrBefore(path, statLen);
-
-    ffStrbufAppendS(path, "rx_errors");
-    if (ffReadFileBuffer(path->chars, buffer))
-        counters->rxErrors = ffStrbufToUInt(buffer, 0);
-    ffStrbufSubstrBefore(path, statLen);
-
-    ffStrbufAppendS(path, "tx_errors");
-    if (ffReadFileBuffer(path->chars, buffer))
-        counters->txErrors = ffStrbufToUInt(buffer, 0);
-    ffStrbufSubstrBefore(path, statLen);
-
-    ffStrbufAppendS(path, "rx_dropped");
-    if (ffReadFileBuffer(path->chars, buffer))
-        counters->rxDrops = ffStrbufToUInt(buffer, 0);
-    ffStrbufSubstrBefore(path, statLen);
-
-    ffStrbufAppendS(path, "tx_dropped");
-    if (ffReadFileBuffer(path->chars, buffer))
-        counters->txDrops = ffStrbufToUInt(buffer, 0);
-    ffStrbufSubstrBefore(path, statLen);
+
+    ffStrbufSetF(path, "/sys/class/net/%s/statistics", ifName);
+    FF_AUTO_CLOSE_FD int dfd = open(path->chars, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dfd < 0)
+        return;
+
+    enum { FF_NETIO_STAT_COUNT = 8 };
+    static const char* const fileNames[FF_NETIO_STAT_COUNT] = {
+        "rx_bytes", "tx_bytes", "rx_packets", "tx_packets",
+        "rx_errors", "tx_errors", "rx_dropped", "tx_dropped",
+    };
+    uint64_t* const values[FF_NETIO_STAT_COUNT] = {
+        &counters->rxBytes, &counters->txBytes, &counters->rxPackets, &counters->txPackets,
+        &counters->rxErrors, &counters->txErrors, &counters->rxDrops, &counters->txDrops,
+    };
+
+    FFstrbuf buffers[FF_NETIO_STAT_COUNT];
+    FFReadFileBatchItem items[FF_NETIO_STAT_COUNT];
+    for (uint32_t i = 0; i < FF_NETIO_STAT_COUNT; ++i)
+    {
+        ffStrbufInit(&buffers[i]);
+        items[i] = (FFReadFileBatchItem) { .dfd = dfd, .fileName = fileNames[i], .buffer = &buffers[i] };
+    }
+
+    ffReadFileBatch(items, FF_NETIO_STAT_COUNT);
+
+    for (uint32_t i = 0; i < FF_NETIO_STAT_COUNT; ++i)
+    {
+        if (items[i].success)
+            *values[i] = ffStrbufToUInt(&buffers[i], 0);
+        ffStrbufDestroy(&buffers[i]);
+    }
 }
 
 const char* ffNetIOGetIoCounters(FFlist* result, FFNetIOOptions* options)
@@ -1,5 +1,6 @@
 #include "detection/opencl/opencl.h"
 #include "detection/gpu/gpu.h"
+#include "common/thread.h"
 
 #if !defined(FF_HAVE_OPENCL) && defined(__APPLE__) && defined(MAC_OS_X_VERSION_10_15)
     #define FF_HAVE_OPENCL 1
@@ -197,8 +198,9 @@ static const char* detectOpenCL(FFOpenCLResult* result)
 FFOpenCLResult* ffDetectOpenCL(void)
 {
     static FFOpenCLResult result;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
 
-    if (result.gpus.elementSize == 0)
+    FF_ONCE(&once)
     {
         ffStrbufInit(&result.version);
         ffStrbufInit(&result.name);
@@ -14,4 +14,6 @@ typedef struct FFOpenGLResult
 #define FF_OPENGL_BUFFER_WIDTH 1
 #define FF_OPENGL_BUFFER_HEIGHT 1
 
+// Serialized, because both the OpenGL and the GPU module use it, and GL drivers may not be thread-safe
 const char* ffDetectOpenGL(FFOpenGLOptions* options, FFOpenGLResult* result);
+const char* ffDetectOpenGLImpl(FFOpenGLOptions* options, FFOpenGLResult* result);
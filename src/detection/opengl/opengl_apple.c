@@ -52,7 +52,7 @@ const char* cglDetectOpenGL(FFOpenGLResult* result)
     return error;
 }
 
-const char* ffDetectOpenGL(FFOpenGLOptions* options, FFOpenGLResult* result)
+const char* ffDetectOpenGLImpl(FFOpenGLOptions* options, FFOpenGLResult* result)
 {
     if (options->library == FF_OPENGL_LIBRARY_AUTO)
         return cglDetectOpenGL(result);
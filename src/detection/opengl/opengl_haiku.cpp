@@ -22,7 +22,7 @@ static const char* oglDetectOpenGL(FFOpenGLResult* result)
     return NULL;
 }
 
-const char* ffDetectOpenGL(FFOpenGLOptions* options, FFOpenGLResult* result)
+const char* ffDetectOpenGLImpl(FFOpenGLOptions* options, FFOpenGLResult* result)
 {
     if (options->library == FF_OPENGL_LIBRARY_AUTO)
         return oglDetectOpenGL(result);
@@ -155,7 +155,7 @@ static const char* detectByGlx(FFOpenGLResult* result)
 
 #endif //FF_HAVE_GLX
 
-const char* ffDetectOpenGL(FFOpenGLOptions* options, FFOpenGLResult* result)
+const char* ffDetectOpenGLImpl(FFOpenGLOptions* options, FFOpenGLResult* result)
 {
     #if FF_HAVE_GL
 
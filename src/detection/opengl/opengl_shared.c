@@ -1,5 +1,6 @@
 #include "opengl.h"
 #include "common/library.h"
+#include "common/thread.h"
 
 #if __has_include(<GL/gl.h>)
 #include <GL/gl.h>
@@ -161,3 +162,12 @@ const char* ffOpenGLDetectByEGL(FFOpenGLResult* result)
 #endif //FF_HAVE_EGL
 
 #endif //FF_HAVE_NO_GL
+
+const char* ffDetectOpenGL(FFOpenGLOptions* options, FFOpenGLResult* result)
+{
+    static FFThreadMutex mutex = FF_THREAD_MUTEX_INITIALIZER;
+    ffThreadMutexLock(&mutex);
+    const char* error = ffDetectOpenGLImpl(options, result);
+    ffThreadMutexUnlock(&mutex);
+    return error;
+}
@@ -110,7 +110,7 @@ static const char* wglDetectOpenGL(FFOpenGLResult* result)
 }
 
 
-const char* ffDetectOpenGL(FFOpenGLOptions* options, FFOpenGLResult* result)
+const char* ffDetectOpenGLImpl(FFOpenGLOptions* options, FFOpenGLResult* result)
 {
     if (options->library == FF_OPENGL_LIBRARY_AUTO)
         return wglDetectOpenGL(result);
@@ -1,11 +1,13 @@
 #include "os.h"
+#include "common/thread.h"
 
 void ffDetectOSImpl(FFOSResult* os);
 
 const FFOSResult* ffDetectOS(void)
 {
     static FFOSResult result;
-    if (result.name.chars == NULL)
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+    FF_ONCE(&once)
     {
         ffStrbufInit(&result.name);
         ffStrbufInit(&result.prettyName);
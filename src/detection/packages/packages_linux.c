@@ -411,13 +411,12 @@ static uint32_t getAMSystem(FFstrbuf* baseDir)
 static uint32_t getAMUser(void)
 {
     // check if $XDG_CONFIG_HOME/appman/appman-config exists
-    FFstrbuf* baseDir = FF_LIST_GET(FFstrbuf, instance.state.platform.configDirs, 0);
-    uint32_t baseLen = baseDir->length;
-    ffStrbufAppendS(baseDir, "appman/appman-config");
+    // Copy the dir, because it may be used by other detection threads
+    FF_STRBUF_AUTO_DESTROY baseDir = ffStrbufCreateCopy(FF_LIST_GET(FFstrbuf, instance.state.platform.configDirs, 0));
+    ffStrbufAppendS(&baseDir, "appman/appman-config");
     FF_STRBUF_AUTO_DESTROY packagesPath = ffStrbufCreate();
-    if (ffReadFileBuffer(baseDir->chars, &packagesPath))
+    if (ffReadFileBuffer(baseDir.chars, &packagesPath))
         ffStrbufTrimRightSpace(&packagesPath);
-    ffStrbufSubstrBefore(baseDir, baseLen);
 
     return packagesPath.length > 0 ? getAMPackages(&packagesPath) : 0;
 }
@@ -1,54 +1,168 @@
 #include "publicip.h"
+#include "common/cache.h"
+#include "common/processing.h"
 #include "common/networking/networking.h"
 
-#define FF_UNITIALIZED ((const char*)(uintptr_t) -1)
-static FFNetworkingState states[2];
-static const char* statuses[2] = { FF_UNITIALIZED, FF_UNITIALIZED };
+typedef struct FFPublicIpRequest
+{
+    FFNetworkingState state;
+    FFstrbuf host;
+    FFstrbuf path;
+    bool ipv6;
+    bool received; // `body` and `error` hold the response
+    bool useCached; // no request is sent
+    const char* error; // of sending the request until received
+    FFstrbuf cachePath; // empty if the response is not cached
+    FFstrbuf body; // the cached response body until received
+} FFPublicIpRequest;
 
-void ffPreparePublicIp(FFPublicIpOptions* options)
+// Requests of all occurrences of the module, which are prepared on the main thread, and received one by one.
+// Elements are allocated separately, because a request may be sent on the thread pool while more are added
+static FFlist requests; // FFPublicIpRequest*
+
+static const char* sendRequest(FFPublicIpRequest* request)
+{
+    return ffNetworkingSendHttpRequest(&request->state, request->host.chars, request->path.chars, NULL);
+}
+
+static const char* recvResponse(FFPublicIpRequest* request, FFstrbuf* response)
 {
-    FFNetworkingState* state = &states[options->ipv6];
-    const char** status = &statuses[options->ipv6];
-    if (*status != FF_UNITIALIZED)
+    const char* error = ffNetworkingRecvHttpResponse(&request->state, response);
+    if (error)
+        return error;
+
+    bool ok = ffNetworkingIsHttpOk(response);
+    ffStrbufSubstrAfterFirstS(response, "\r\n\r\n");
+    if (response->length == 0)
+        return "Empty server response received";
+
+    if (ok && request->cachePath.length)
+        ffCacheSaveTtl(request->cachePath.chars, response);
+    return NULL;
+}
+
+static void refreshCache(void* data)
+{
+    FFPublicIpRequest* request = data;
+    if (sendRequest(request) == NULL)
     {
-        fputs("Error: PublicIp module can only be used once due to internal limitations\n", stderr);
-        exit(1);
+        FF_STRBUF_AUTO_DESTROY response = ffStrbufCreateA(4096);
+        recvResponse(request, &response);
     }
+}
 
-    state->timeout = options->timeout;
-    state->ipv6 = options->ipv6;
-
+static void parseUrl(const FFPublicIpOptions* options, FFstrbuf* host, FFstrbuf* path)
+{
     if (options->url.length == 0)
     {
-        state->compression = true;
-        state->tfo = true;
-        *status = ffNetworkingSendHttpRequest(state, options->ipv6 ? "v6.ipinfo.io" : "ipinfo.io", "/json", NULL);
+        ffStrbufSetS(host, options->ipv6 ? "v6.ipinfo.io" : "ipinfo.io");
+        ffStrbufSetS(path, "/json");
+        return;
+    }
+
+    ffStrbufSet(host, &options->url);
+    uint32_t hostStartIndex = ffStrbufFirstIndexS(host, "://");
+    if (hostStartIndex < host->length)
+    {
+        if (hostStartIndex != 4 || !ffStrbufStartsWithIgnCaseS(host, "http"))
+        {
+            fputs("Error: only http: protocol is supported. Use `Command` module with `curl` if needed\n", stderr);
+            exit(1);
+        }
+        ffStrbufSubstrAfter(host, hostStartIndex + (uint32_t) (strlen("://") - 1));
+    }
+
+    uint32_t pathStartIndex = ffStrbufFirstIndexC(host, '/');
+    if (pathStartIndex != host->length)
+    {
+        ffStrbufSetNS(path, host->length - pathStartIndex, host->chars + pathStartIndex);
+        ffStrbufSubstrBefore(host, pathStartIndex);
     }
     else
+        ffStrbufSetS(path, "/");
+}
+
+static FFPublicIpRequest* prepareRequest(FFPublicIpOptions* options)
+{
+    FF_STRBUF_AUTO_DESTROY host = ffStrbufCreate();
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    parseUrl(options, &host, &path);
+
+    if (requests.elementSize == 0)
+        ffListInit(&requests, sizeof(FFPublicIpRequest*));
+
+    // Occurrences with the same endpoint share the request
+    FF_LIST_FOR_EACH(FFPublicIpRequest*, pRequest, requests)
     {
-        FF_STRBUF_AUTO_DESTROY host = ffStrbufCreateCopy(&options->url);
-        uint32_t hostStartIndex = ffStrbufFirstIndexS(&host, "://");
-        if (hostStartIndex < host.length)
+        FFPublicIpRequest* request = *pRequest;
+        if (request->ipv6 == options->ipv6 && ffStrbufEqual(&request->host, &host) && ffStrbufEqual(&request->path, &path))
+            return request;
+    }
+
+    FFPublicIpRequest* request = calloc(1, sizeof(*request));
+    *(FFPublicIpRequest**) ffListAdd(&requests) = request;
+
+    request->state.timeout = options->timeout;
+    request->state.ipv6 = options->ipv6;
+    if (options->url.length == 0)
+    {
+        request->state.compression = true;
+        request->state.tfo = true;
+    }
+    request->ipv6 = options->ipv6;
+    ffStrbufInitMove(&request->host, &host);
+    ffStrbufInitMove(&request->path, &path);
+    ffStrbufInit(&request->cachePath);
+    ffStrbufInit(&request->body);
+
+    if (options->cacheTtl > 0)
+    {
+        FF_STRBUF_AUTO_DESTROY key = ffStrbufCreateCopy(&request->host);
+        ffStrbufAppendC(&key, '\0');
+        ffStrbufAppend(&key, &request->path);
+        ffStrbufAppendC(&key, '\0');
+        ffStrbufAppendC(&key, options->ipv6 ? '6' : '4');
+
+        if (ffCacheGetTtlPath("publicip", &key, &request->cachePath))
         {
-            if (hostStartIndex != 4 || !ffStrbufStartsWithIgnCaseS(&host, "http"))
+            switch (ffCacheLoadTtl(request->cachePath.chars, options->cacheTtl, NULL, &request->body))
             {
-                fputs("Error: only http: protocol is supported. Use `Command` module with `curl` if needed\n", stderr);
-                exit(1);
+                case FF_CACHE_TTL_FRESH:
+                    request->useCached = true;
+                    break;
+                case FF_CACHE_TTL_STALE:
+                    request->useCached = options->cacheStaleWhileRevalidate && ffProcessForkDetached(refreshCache, request) == NULL;
+                    break;
+                default:
+                    break;
             }
-            ffStrbufSubstrAfter(&host, hostStartIndex + (uint32_t) (strlen("://") - 1));
         }
-        uint32_t pathStartIndex = ffStrbufFirstIndexC(&host, '/');
+    }
 
-        FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
-        if(pathStartIndex != host.length)
-        {
-            ffStrbufAppendNS(&path, pathStartIndex, host.chars + (host.length - pathStartIndex));
-            host.length = pathStartIndex;
-            host.chars[pathStartIndex] = '\0';
-        }
+    if (request->useCached)
+        request->received = true;
+    else
+        request->error = sendRequest(request);
+    return request;
+}
 
-        *status = ffNetworkingSendHttpRequest(state, host.chars, path.length == 0 ? "/" : path.chars, NULL);
-    }
+void ffPreparePublicIp(FFPublicIpOptions* options)
+{
+    prepareRequest(options);
+}
+
+static void receiveRequest(FFPublicIpRequest* request)
+{
+    request->received = true;
+
+    FF_STRBUF_AUTO_DESTROY response = ffStrbufCreateA(4096);
+    if (request->error == NULL)
+        request->error = recvResponse(request, &response);
+
+    if (request->error == NULL)
+        ffStrbufSet(&request->body, &response);
+    else if (request->body.length > 0)
+        request->error = NULL; // Better an outdated response than none
 }
 
 static inline void wrapYyjsonFree(yyjson_doc** doc)
@@ -60,27 +174,16 @@ static inline void wrapYyjsonFree(yyjson_doc** doc)
 
 const char* ffDetectPublicIp(FFPublicIpOptions* options, FFPublicIpResult* result)
 {
-    FFNetworkingState* state = &states[options->ipv6];
-    const char** status = &statuses[options->ipv6];
-    if (*status == FF_UNITIALIZED)
-        ffPreparePublicIp(options);
-
-    if (*status != NULL)
-        return *status;
+    FFPublicIpRequest* request = prepareRequest(options);
+    if (!request->received)
+        receiveRequest(request);
 
-    FF_STRBUF_AUTO_DESTROY response = ffStrbufCreateA(4096);
-    const char* error = ffNetworkingRecvHttpResponse(state, &response);
-    if (error == NULL)
-        ffStrbufSubstrAfterFirstS(&response, "\r\n\r\n");
-    else
-        return error;
-
-    if (response.length == 0)
-        return "Empty server response received";
+    if (request->error)
+        return request->error;
 
     if (options->url.length == 0)
     {
-        yyjson_doc* __attribute__((__cleanup__(wrapYyjsonFree))) doc = yyjson_read_opts(response.chars, response.length, 0, NULL, NULL);
+        yyjson_doc* __attribute__((__cleanup__(wrapYyjsonFree))) doc = yyjson_read_opts(request->body.chars, request->body.length, 0, NULL, NULL);
         if (doc)
         {
             yyjson_val* root = yyjson_doc_get_root(doc);
@@ -91,8 +194,7 @@ const char* ffDetectPublicIp(FFPublicIpOptions* options, FFPublicIpResult* resul
         }
     }
 
-    ffStrbufDestroy(&result->ip);
-    ffStrbufInitMove(&result->ip, &response);
+    ffStrbufSet(&result->ip, &request->body);
     ffStrbufTrimRightSpace(&result->ip);
     return NULL;
 }
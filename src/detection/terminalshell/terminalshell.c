@@ -1,9 +1,11 @@
 #include "fastfetch.h"
+#include "common/cache.h"
 #include "common/io/io.h"
 #include "common/processing.h"
 #include "common/properties.h"
 #include "util/stringUtils.h"
 #include "util/binary.h"
+#include "util/path.h"
 
 #include <ctype.h>
 #ifdef __FreeBSD__
@@ -258,10 +260,8 @@ static bool getShellVersionWinPowerShell(FFstrbuf* exe, FFstrbuf* version)
 }
 #endif
 
-bool fftsGetShellVersion(FFstrbuf* exe, const char* exeName, FFstrbuf* exePath, FFstrbuf* version)
+static bool getShellVersion(FFstrbuf* exe, const char* exeName, FFstrbuf* exePath, FFstrbuf* version)
 {
-    if (!instance.config.general.detectVersion) return false;
-
     if(ffStrEqualsIgnCase(exeName, "sh")) // #849
         return false;
 
@@ -300,6 +300,28 @@ bool fftsGetShellVersion(FFstrbuf* exe, const char* exeName, FFstrbuf* exePath,
     return false;
 }
 
+// The versions are cached by the real path of the executable, which must be known
+static const char* getVersionCacheKey(const FFstrbuf* exePath)
+{
+    return exePath->length > 0 && ffIsAbsolutePath(exePath->chars) ? exePath->chars : NULL;
+}
+
+bool fftsGetShellVersion(FFstrbuf* exe, const char* exeName, FFstrbuf* exePath, FFstrbuf* version)
+{
+    if (!instance.config.general.detectVersion) return false;
+
+    const char* cacheKey = getVersionCacheKey(exePath);
+    if (cacheKey && ffCacheGetExeVersion(cacheKey, version))
+        return true;
+
+    if (!getShellVersion(exe, exeName, exePath, version))
+        return false;
+
+    if (cacheKey)
+        ffCacheSetExeVersion(cacheKey, version);
+    return true;
+}
+
 FF_MAYBE_UNUSED static bool getTerminalVersionTermux(FFstrbuf* version)
 {
     ffStrbufSetS(version, getenv("TERMUX_VERSION"));
@@ -755,10 +777,8 @@ static bool getTerminalVersionConEmu(FFstrbuf* exe, FFstrbuf* version)
 
 #endif
 
-bool fftsGetTerminalVersion(FFstrbuf* processName, FF_MAYBE_UNUSED FFstrbuf* exe, FFstrbuf* version)
+static bool getTerminalVersion(FFstrbuf* processName, FF_MAYBE_UNUSED FFstrbuf* exe, FFstrbuf* version)
 {
-    if (!instance.config.general.detectVersion) return false;
-
     #ifdef __ANDROID__
 
     if(ffStrbufEqualS(processName, "com.termux"))
@@ -928,3 +948,19 @@ bool fftsGetTerminalVersion(FFstrbuf* processName, FF_MAYBE_UNUSED FFstrbuf* exe
 
     #endif
 }
+
+bool fftsGetTerminalVersion(FFstrbuf* processName, FFstrbuf* exe, const FFstrbuf* exePath, FFstrbuf* version)
+{
+    if (!instance.config.general.detectVersion) return false;
+
+    const char* cacheKey = getVersionCacheKey(exePath);
+    if (cacheKey && ffCacheGetExeVersion(cacheKey, version))
+        return true;
+
+    if (!getTerminalVersion(processName, exe, version))
+        return false;
+
+    if (cacheKey)
+        ffCacheSetExeVersion(cacheKey, version);
+    return true;
+}
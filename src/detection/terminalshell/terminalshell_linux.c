@@ -1,4 +1,5 @@
 #include "terminalshell.h"
+#include "common/daemon.h"
 #include "common/io/io.h"
 #include "common/parsing.h"
 #include "common/processing.h"
@@ -286,7 +287,7 @@ static void getUserShellFromEnv(FFShellResult* result)
 
 bool fftsGetShellVersion(FFstrbuf* exe, const char* exeName, FFstrbuf* exePath, FFstrbuf* version);
 
-bool fftsGetTerminalVersion(FFstrbuf* processName, FFstrbuf* exe, FFstrbuf* version);
+bool fftsGetTerminalVersion(FFstrbuf* processName, FFstrbuf* exe, const FFstrbuf* exePath, FFstrbuf* version);
 
 static void setShellInfoDetails(FFShellResult* result)
 {
@@ -375,7 +376,7 @@ static void setTerminalInfoDetails(FFTerminalResult* result)
     else
         ffStrbufInitCopy(&result->prettyName, &result->processName);
 
-    fftsGetTerminalVersion(&result->processName, &result->exe, &result->version);
+    fftsGetTerminalVersion(&result->processName, &result->exe, &result->exePath, &result->version);
 }
 
 #if defined(MAXPATH)
@@ -386,24 +387,18 @@ static void setTerminalInfoDetails(FFTerminalResult* result)
 #define FF_EXE_PATH_LEN 260
 #endif
 
-const FFShellResult* ffDetectShell()
+static void detectShell(FFShellResult* result)
 {
-    static FFShellResult result;
-    static bool init = false;
-    if(init)
-        return &result;
-    init = true;
-
-    ffStrbufInit(&result.processName);
-    ffStrbufInitA(&result.exe, FF_EXE_PATH_LEN);
-    result.exeName = result.exe.chars;
-    ffStrbufInit(&result.exePath);
-    ffStrbufInit(&result.version);
-    result.pid = 0;
-    result.ppid = 0;
-    result.tty = -1;
-
-    pid_t ppid = getppid();
+    ffStrbufInit(&result->processName);
+    ffStrbufInitA(&result->exe, FF_EXE_PATH_LEN);
+    result->exeName = result->exe.chars;
+    ffStrbufInit(&result->exePath);
+    ffStrbufInit(&result->version);
+    result->pid = 0;
+    result->ppid = 0;
+    result->tty = -1;
+
+    pid_t ppid = ffDaemonGetParentPid();
 
     const char* ignoreParent = getenv("FFTS_IGNORE_PARENT");
     if (ignoreParent && ffStrEquals(ignoreParent, "1"))
@@ -412,36 +407,44 @@ const FFShellResult* ffDetectShell()
         ffProcessGetBasicInfoLinux(ppid, &_, &ppid, NULL);
     }
 
-    ppid = getShellInfo(&result, ppid);
-    getUserShellFromEnv(&result);
-    setShellInfoDetails(&result);
+    ppid = getShellInfo(result, ppid);
+    getUserShellFromEnv(result);
+    setShellInfoDetails(result);
+}
 
+const FFShellResult* ffDetectShell()
+{
+    static FFShellResult result;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+    FF_ONCE(&once)
+        detectShell(&result);
     return &result;
 }
 
-const FFTerminalResult* ffDetectTerminal()
+static void detectTerminal(FFTerminalResult* result)
 {
-    static FFTerminalResult result;
-    static bool init = false;
-    if(init)
-        return &result;
-    init = true;
-
-    ffStrbufInit(&result.processName);
-    ffStrbufInitA(&result.exe, FF_EXE_PATH_LEN);
-    result.exeName = result.exe.chars;
-    ffStrbufInit(&result.exePath);
-    ffStrbufInit(&result.version);
-    ffStrbufInitS(&result.tty, ttyname(STDOUT_FILENO));
-    result.pid = 0;
-    result.ppid = 0;
+    ffStrbufInit(&result->processName);
+    ffStrbufInitA(&result->exe, FF_EXE_PATH_LEN);
+    result->exeName = result->exe.chars;
+    ffStrbufInit(&result->exePath);
+    ffStrbufInit(&result->version);
+    ffStrbufInitS(&result->tty, ttyname(STDOUT_FILENO));
+    result->pid = 0;
+    result->ppid = 0;
 
     pid_t ppid = (pid_t) ffDetectShell()->ppid;
 
     if (ppid)
-        ppid = getTerminalInfo(&result, ppid);
-    getTerminalFromEnv(&result);
-    setTerminalInfoDetails(&result);
+        ppid = getTerminalInfo(result, ppid);
+    getTerminalFromEnv(result);
+    setTerminalInfoDetails(result);
+}
 
+const FFTerminalResult* ffDetectTerminal()
+{
+    static FFTerminalResult result;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+    FF_ONCE(&once)
+        detectTerminal(&result);
     return &result;
 }
@@ -296,81 +296,83 @@ static void setTerminalInfoDetails(FFTerminalResult* result)
     }
 }
 
-bool fftsGetTerminalVersion(FFstrbuf* processName, FFstrbuf* exe, FFstrbuf* version);
+bool fftsGetTerminalVersion(FFstrbuf* processName, FFstrbuf* exe, const FFstrbuf* exePath, FFstrbuf* version);
 
-const FFShellResult* ffDetectShell(void)
+static void detectShell(FFShellResult* result)
 {
-    static FFShellResult result;
-    static bool init = false;
-    if(init)
-        return &result;
-    init = true;
-
-    ffStrbufInit(&result.processName);
-    ffStrbufInitA(&result.exe, MAX_PATH);
-    result.exeName = "";
-    ffStrbufInit(&result.exePath);
-    ffStrbufInit(&result.prettyName);
-    ffStrbufInit(&result.version);
-    result.pid = 0;
-    result.ppid = 0;
-    result.tty = -1;
+    ffStrbufInit(&result->processName);
+    ffStrbufInitA(&result->exe, MAX_PATH);
+    result->exeName = "";
+    ffStrbufInit(&result->exePath);
+    ffStrbufInit(&result->prettyName);
+    ffStrbufInit(&result->version);
+    result->pid = 0;
+    result->ppid = 0;
+    result->tty = -1;
 
     uint32_t ppid;
     if(!ffProcessGetInfoWindows(0, &ppid, NULL, NULL, NULL, NULL, NULL))
-        return &result;
+        return;
 
     const char* ignoreParent = getenv("FFTS_IGNORE_PARENT");
     if (ignoreParent && ffStrEquals(ignoreParent, "1"))
         ffProcessGetInfoWindows(ppid, &ppid, NULL, NULL, NULL, NULL, NULL);
 
-    ppid = getShellInfo(&result, ppid);
+    ppid = getShellInfo(result, ppid);
 
-    if (result.processName.length > 0)
+    if (result->processName.length > 0)
     {
-        setShellInfoDetails(&result);
+        setShellInfoDetails(result);
         char tmp[MAX_PATH];
-        strcpy(tmp, result.exeName);
+        strcpy(tmp, result->exeName);
         char* ext = strrchr(tmp, '.');
         if (ext) *ext = '\0';
-        fftsGetShellVersion(&result.exe, tmp, &result.exePath, &result.version);
+        fftsGetShellVersion(&result->exe, tmp, &result->exePath, &result->version);
     }
+}
 
+const FFShellResult* ffDetectShell(void)
+{
+    static FFShellResult result;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+    FF_ONCE(&once)
+        detectShell(&result);
     return &result;
 }
 
-const FFTerminalResult* ffDetectTerminal(void)
+static void detectTerminal(FFTerminalResult* result)
 {
-    static FFTerminalResult result;
-    static bool init = false;
-    if(init)
-        return &result;
-    init = true;
-
-    ffStrbufInit(&result.processName);
-    ffStrbufInitA(&result.exe, MAX_PATH);
-    result.exeName = "";
-    ffStrbufInit(&result.exePath);
-    ffStrbufInit(&result.prettyName);
-    ffStrbufInit(&result.version);
-    ffStrbufInit(&result.tty);
-    result.pid = 0;
-    result.ppid = 0;
+    ffStrbufInit(&result->processName);
+    ffStrbufInitA(&result->exe, MAX_PATH);
+    result->exeName = "";
+    ffStrbufInit(&result->exePath);
+    ffStrbufInit(&result->prettyName);
+    ffStrbufInit(&result->version);
+    ffStrbufInit(&result->tty);
+    result->pid = 0;
+    result->ppid = 0;
 
     uint32_t ppid = ffDetectShell()->ppid;
     if(ppid)
-        getTerminalInfo(&result, ppid);
+        getTerminalInfo(result, ppid);
 
-    if(result.processName.length == 0)
-        getTerminalFromEnv(&result);
-    if(result.processName.length == 0)
-        detectDefaultTerminal(&result);
+    if(result->processName.length == 0)
+        getTerminalFromEnv(result);
+    if(result->processName.length == 0)
+        detectDefaultTerminal(result);
 
-    if(result.processName.length > 0)
+    if(result->processName.length > 0)
     {
-        setTerminalInfoDetails(&result);
-        fftsGetTerminalVersion(&result.processName, &result.exe, &result.version);
+        setTerminalInfoDetails(result);
+        fftsGetTerminalVersion(&result->processName, &result->exe, &result->exePath, &result->version);
     }
+}
 
+const FFTerminalResult* ffDetectTerminal(void)
+{
+    static FFTerminalResult result;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+    FF_ONCE(&once)
+        detectTerminal(&result);
     return &result;
 }
@@ -1,6 +1,7 @@
 #include "fastfetch.h"
 #include "detection/gpu/gpu.h"
 #include "detection/vulkan/vulkan.h"
+#include "common/thread.h"
 
 #ifdef FF_HAVE_VULKAN
 #include "common/library.h"
@@ -258,8 +259,9 @@ static const char* detectVulkan(FFVulkanResult* result)
 FFVulkanResult* ffDetectVulkan(void)
 {
     static FFVulkanResult result;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
 
-    if (result.gpus.elementSize == 0)
+    FF_ONCE(&once)
     {
         ffStrbufInit(&result.driver);
         ffStrbufInit(&result.apiVersion);
@@ -1,20 +1,57 @@
 #include "weather.h"
+#include "common/cache.h"
+#include "common/processing.h"
 #include "common/networking/networking.h"
 
-#define FF_UNITIALIZED ((const char*)(uintptr_t) -1)
-static FFNetworkingState state;
-static const char* status = FF_UNITIALIZED;
+typedef struct FFWeatherRequest
+{
+    FFNetworkingState state;
+    FFstrbuf path;
+    bool received; // `body` and `error` hold the response
+    bool useCached; // no request is sent
+    const char* error; // of sending the request until received
+    FFstrbuf cachePath; // empty if the response is not cached
+    FFstrbuf body; // the cached response body until received
+} FFWeatherRequest;
 
-void ffPrepareWeather(FFWeatherOptions* options)
+// Requests of all occurrences of the module, which are prepared on the main thread, and received one by one.
+// Elements are allocated separately, because a request may be sent on the thread pool while more are added
+static FFlist requests; // FFWeatherRequest*
+
+static const char* sendRequest(FFWeatherRequest* request)
+{
+    return ffNetworkingSendHttpRequest(&request->state, "wttr.in", request->path.chars, "User-Agent: curl/0.0.0\r\n");
+}
+
+static const char* recvResponse(FFWeatherRequest* request, FFstrbuf* response)
+{
+    const char* error = ffNetworkingRecvHttpResponse(&request->state, response);
+    if (error)
+        return error;
+
+    bool ok = ffNetworkingIsHttpOk(response);
+    ffStrbufSubstrAfterFirstS(response, "\r\n\r\n");
+    ffStrbufTrimRightSpace(response);
+    if (response->length == 0)
+        return "Empty server response received";
+
+    if (ok && request->cachePath.length)
+        ffCacheSaveTtl(request->cachePath.chars, response);
+    return NULL;
+}
+
+static void refreshCache(void* data)
 {
-    if (status != FF_UNITIALIZED)
+    FFWeatherRequest* request = data;
+    if (sendRequest(request) == NULL)
     {
-        fputs("Error: Weather module can only be used once due to internal limitations\n", stderr);
-        exit(1);
+        FF_STRBUF_AUTO_DESTROY response = ffStrbufCreateA(4096);
+        recvResponse(request, &response);
     }
+}
 
-    state.timeout = options->timeout;
-
+static FFWeatherRequest* prepareRequest(FFWeatherOptions* options)
+{
     FF_STRBUF_AUTO_DESTROY path = ffStrbufCreateS("/");
     if (options->location.length)
         ffStrbufAppend(&path, &options->location);
@@ -31,29 +68,75 @@ void ffPrepareWeather(FFWeatherOptions* options)
         default:
             break;
     }
-    status = ffNetworkingSendHttpRequest(&state, "wttr.in", path.chars, "User-Agent: curl/0.0.0\r\n");
-}
 
-const char* ffDetectWeather(FFWeatherOptions* options, FFstrbuf* result)
-{
-    if(status == FF_UNITIALIZED)
-        ffPrepareWeather(options);
+    if (requests.elementSize == 0)
+        ffListInit(&requests, sizeof(FFWeatherRequest*));
 
-    if(status != NULL)
-        return status;
+    // Occurrences with the same location and format share the request
+    FF_LIST_FOR_EACH(FFWeatherRequest*, pRequest, requests)
+    {
+        if (ffStrbufEqual(&(*pRequest)->path, &path))
+            return *pRequest;
+    }
+
+    FFWeatherRequest* request = calloc(1, sizeof(*request));
+    *(FFWeatherRequest**) ffListAdd(&requests) = request;
 
-    ffStrbufEnsureFree(result, 4095);
-    const char* error = ffNetworkingRecvHttpResponse(&state, result);
-    if (error == NULL)
+    request->state.timeout = options->timeout;
+    ffStrbufInitMove(&request->path, &path);
+    ffStrbufInit(&request->cachePath);
+    ffStrbufInit(&request->body);
+
+    if (options->cacheTtl > 0 && ffCacheGetTtlPath("weather", &request->path, &request->cachePath))
     {
-        ffStrbufSubstrAfterFirstS(result, "\r\n\r\n");
-        ffStrbufTrimRightSpace(result);
+        switch (ffCacheLoadTtl(request->cachePath.chars, options->cacheTtl, NULL, &request->body))
+        {
+            case FF_CACHE_TTL_FRESH:
+                request->useCached = true;
+                break;
+            case FF_CACHE_TTL_STALE:
+                request->useCached = options->cacheStaleWhileRevalidate && ffProcessForkDetached(refreshCache, request) == NULL;
+                break;
+            default:
+                break;
+        }
     }
+
+    if (request->useCached)
+        request->received = true;
     else
-        return error;
+        request->error = sendRequest(request);
+    return request;
+}
 
-    if(result->length == 0)
-        return "Empty server response received";
+void ffPrepareWeather(FFWeatherOptions* options)
+{
+    prepareRequest(options);
+}
+
+static void receiveRequest(FFWeatherRequest* request)
+{
+    request->received = true;
+
+    FF_STRBUF_AUTO_DESTROY response = ffStrbufCreateA(4096);
+    if (request->error == NULL)
+        request->error = recvResponse(request, &response);
+
+    if (request->error == NULL)
+        ffStrbufSet(&request->body, &response);
+    else if (request->body.length > 0)
+        request->error = NULL; // Better an outdated response than none
+}
+
+const char* ffDetectWeather(FFWeatherOptions* options, FFstrbuf* result)
+{
+    FFWeatherRequest* request = prepareRequest(options);
+    if (!request->received)
+        receiveRequest(request);
+
+    if (request->error)
+        return request->error;
 
+    ffStrbufSet(result, &request->body);
     return NULL;
 }
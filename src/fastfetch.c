@@ -1,5 +1,6 @@
 #include "fastfetch.h"
 #include "common/commandoption.h"
+#include "common/daemon.h"
 #include "common/io/io.h"
 #include "common/jsonconfig.h"
 #include "common/printing.h"
@@ -759,7 +760,7 @@ static void writeConfigFile(FFdata* data, const FFstrbuf* filename)
     yyjson_mut_doc_free(doc);
 }
 
-int main(int argc, char** argv)
+static int fastfetchMain(int argc, char** argv)
 {
     ffInitInstance();
     atexit(ffDestroyInstance);
@@ -781,4 +782,38 @@ int main(int argc, char** argv)
         writeConfigFile(&data, &instance.state.genConfigPath);
 
     ffStrbufDestroy(&data.structure);
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && ffStrEquals(argv[1], "--daemon"))
+    {
+        if (argc > 2)
+        {
+            fputs("Error: --daemon takes no other arguments. Clients send their own\n", stderr);
+            return EXIT_FAILURE;
+        }
+        return ffDaemonServe(fastfetchMain);
+    }
+
+    bool client = argc > 1 && ffStrEquals(argv[1], "--client");
+    if (client)
+    {
+        memmove(&argv[1], &argv[2], (size_t) (argc - 1) * sizeof(*argv)); // Including the NULL terminator
+        --argc;
+    }
+
+    // Let the daemon do the work if it's running
+    int status;
+    if (ffDaemonRequest(argc, argv, &status))
+        return status;
+
+    if (client)
+    {
+        fputs("Error: failed to connect to the daemon at $XDG_RUNTIME_DIR/fastfetch.sock\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    return fastfetchMain(argc, argv);
 }
@@ -9,7 +9,7 @@ int main(void)
     //Modify instance.config here
     FFOptionsModules* const options = &instance.config.modules;
 
-    // ffPrepareCPUUsage();
+    // ffPrepareCPUUsage(&options->cpuUsage);
     // ffPreparePublicIp(&options->publicIP);
     // ffPrepareWeather(&options->weather);
 
@@ -123,11 +123,34 @@ static void printBattery(FFBatteryOptions* options, FFBatteryResult* result, uin
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectBattery(FFBatteryOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectBattery(options, result);
+}
+
+void ffDetectBatteryModule(FFBatteryOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFBatteryResult));
+    detectedError = detectBattery(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintBattery(FFBatteryOptions* options)
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFBatteryResult));
 
-    const char* error = ffDetectBattery(options, &results);
+    const char* error = detectBattery(options, &results);
 
     if (error)
     {
@@ -233,7 +256,7 @@ void ffGenerateBatteryJsonResult(FFBatteryOptions* options, yyjson_mut_doc* doc,
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFBatteryResult));
 
-    const char* error = ffDetectBattery(options, &results);
+    const char* error = detectBattery(options, &results);
     if (error)
     {
         yyjson_mut_obj_add_str(doc, module, "error", error);
@@ -274,6 +297,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print battery capacity, status, etc",
     .parseCommandOptions = (void*) ffParseBatteryCommandOptions,
     .parseJsonObject = (void*) ffParseBatteryJsonObject,
+    .detectModule = (void*) ffDetectBatteryModule,
     .printModule = (void*) ffPrintBattery,
     .generateJsonResult = (void*) ffGenerateBatteryJsonResult,
     .generateJsonConfig = (void*) ffGenerateBatteryJsonConfig,
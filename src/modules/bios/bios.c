@@ -1,9 +1,52 @@
 #include "common/printing.h"
+#include "common/cache.h"
 #include "common/jsonconfig.h"
 #include "detection/bios/bios.h"
 #include "modules/bios/bios.h"
 #include "util/stringUtils.h"
 
+static FFBiosResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const FFCacheField cacheFields[] = {
+    FF_CACHE_FIELD(FFBiosResult, date),
+    FF_CACHE_FIELD(FFBiosResult, release),
+    FF_CACHE_FIELD(FFBiosResult, vendor),
+    FF_CACHE_FIELD(FFBiosResult, version),
+    FF_CACHE_FIELD(FFBiosResult, type),
+};
+
+static const char* detectBios(FF_MAYBE_UNUSED FFBiosOptions* options, FFBiosResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    ffStrbufInit(&result->date);
+    ffStrbufInit(&result->release);
+    ffStrbufInit(&result->vendor);
+    ffStrbufInit(&result->version);
+    ffStrbufInit(&result->type);
+
+    if (ffCacheLoadResult(FF_BIOS_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result))
+        return NULL;
+
+    const char* error = ffDetectBios(result);
+    if (!error)
+        ffCacheSaveResult(FF_BIOS_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result);
+    return error;
+}
+
+void ffDetectBiosModule(FFBiosOptions* options)
+{
+    detectedError = detectBios(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintBios(FFBiosOptions* options)
 {
     FFBiosResult bios;
@@ -13,7 +56,7 @@ void ffPrintBios(FFBiosOptions* options)
     ffStrbufInit(&bios.version);
     ffStrbufInit(&bios.type);
 
-    const char* error = ffDetectBios(&bios);
+    const char* error = detectBios(options, &bios);
 
     FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
 
@@ -119,7 +162,7 @@ void ffGenerateBiosJsonResult(FF_MAYBE_UNUSED FFBiosOptions* options, yyjson_mut
     ffStrbufInit(&bios.version);
     ffStrbufInit(&bios.type);
 
-    const char* error = ffDetectBios(&bios);
+    const char* error = detectBios(options, &bios);
 
     if (error)
     {
@@ -147,6 +190,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print information of 1st-stage bootloader (name, version, release date, etc)",
     .parseCommandOptions = (void*) ffParseBiosCommandOptions,
     .parseJsonObject = (void*) ffParseBiosJsonObject,
+    .detectModule = (void*) ffDetectBiosModule,
     .printModule = (void*) ffPrintBios,
     .generateJsonResult = (void*) ffGenerateBiosJsonResult,
     .generateJsonConfig = (void*) ffGenerateBiosJsonConfig,
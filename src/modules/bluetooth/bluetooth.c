@@ -56,10 +56,33 @@ static void printDevice(FFBluetoothOptions* options, const FFBluetoothResult* de
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectBluetooth(FFBluetoothOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectBluetooth(options, result);
+}
+
+void ffDetectBluetoothModule(FFBluetoothOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFBluetoothResult));
+    detectedError = detectBluetooth(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintBluetooth(FFBluetoothOptions* options)
 {
     FF_LIST_AUTO_DESTROY devices = ffListCreate(sizeof (FFBluetoothResult));
-    const char* error = ffDetectBluetooth(options, &devices);
+    const char* error = detectBluetooth(options, &devices);
 
     if(error)
     {
@@ -159,7 +182,7 @@ void ffGenerateBluetoothJsonResult(FFBluetoothOptions* options, yyjson_mut_doc*
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFBluetoothResult));
 
-    const char* error = ffDetectBluetooth(options, &results);
+    const char* error = detectBluetooth(options, &results);
     if (error)
     {
         yyjson_mut_obj_add_str(doc, module, "error", error);
@@ -191,6 +214,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "List (connected) bluetooth devices",
     .parseCommandOptions = (void*) ffParseBluetoothCommandOptions,
     .parseJsonObject = (void*) ffParseBluetoothJsonObject,
+    .detectModule = (void*) ffDetectBluetoothModule,
     .printModule = (void*) ffPrintBluetooth,
     .generateJsonResult = (void*) ffGenerateBluetoothJsonResult,
     .generateJsonConfig = (void*) ffGenerateBluetoothJsonConfig,
@@ -67,10 +67,33 @@ static void printDevice(FFBluetoothRadioOptions* options, const FFBluetoothRadio
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectBluetoothRadio(FF_MAYBE_UNUSED FFBluetoothRadioOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectBluetoothRadio(result);
+}
+
+void ffDetectBluetoothRadioModule(FFBluetoothRadioOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFBluetoothRadioResult));
+    detectedError = detectBluetoothRadio(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintBluetoothRadio(FFBluetoothRadioOptions* options)
 {
     FF_LIST_AUTO_DESTROY radios = ffListCreate(sizeof (FFBluetoothRadioResult));
-    const char* error = ffDetectBluetoothRadio(&radios);
+    const char* error = detectBluetoothRadio(options, &radios);
 
     if(error)
     {
@@ -144,7 +167,7 @@ void ffGenerateBluetoothRadioJsonResult(FF_MAYBE_UNUSED FFBluetoothRadioOptions*
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFBluetoothRadioResult));
 
-    const char* error = ffDetectBluetoothRadio(&results);
+    const char* error = detectBluetoothRadio(options, &results);
     if (error)
     {
         yyjson_mut_obj_add_str(doc, module, "error", error);
@@ -185,6 +208,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "List bluetooth radios width supported version and vendor",
     .parseCommandOptions = (void*) ffParseBluetoothRadioCommandOptions,
     .parseJsonObject = (void*) ffParseBluetoothRadioJsonObject,
+    .detectModule = (void*) ffDetectBluetoothRadioModule,
     .printModule = (void*) ffPrintBluetoothRadio,
     .generateJsonResult = (void*) ffGenerateBluetoothRadioJsonResult,
     .generateJsonConfig = (void*) ffGenerateBluetoothRadioJsonConfig,
@@ -1,9 +1,50 @@
 #include "common/printing.h"
+#include "common/cache.h"
 #include "common/jsonconfig.h"
 #include "detection/board/board.h"
 #include "modules/board/board.h"
 #include "util/stringUtils.h"
 
+static FFBoardResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const FFCacheField cacheFields[] = {
+    FF_CACHE_FIELD(FFBoardResult, name),
+    FF_CACHE_FIELD(FFBoardResult, vendor),
+    FF_CACHE_FIELD(FFBoardResult, version),
+    FF_CACHE_FIELD(FFBoardResult, serial),
+};
+
+static const char* detectBoard(FF_MAYBE_UNUSED FFBoardOptions* options, FFBoardResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    ffStrbufInit(&result->name);
+    ffStrbufInit(&result->vendor);
+    ffStrbufInit(&result->version);
+    ffStrbufInit(&result->serial);
+
+    if (ffCacheLoadResult(FF_BOARD_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result))
+        return NULL;
+
+    const char* error = ffDetectBoard(result);
+    if (!error)
+        ffCacheSaveResult(FF_BOARD_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result);
+    return error;
+}
+
+void ffDetectBoardModule(FFBoardOptions* options)
+{
+    detectedError = detectBoard(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintBoard(FFBoardOptions* options)
 {
     FFBoardResult result;
@@ -12,7 +53,7 @@ void ffPrintBoard(FFBoardOptions* options)
     ffStrbufInit(&result.version);
     ffStrbufInit(&result.serial);
 
-    const char* error = ffDetectBoard(&result);
+    const char* error = detectBoard(options, &result);
     if(error)
     {
         ffPrintError(FF_BOARD_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
@@ -93,7 +134,7 @@ void ffGenerateBoardJsonResult(FF_MAYBE_UNUSED FFBoardOptions* options, yyjson_m
     ffStrbufInit(&board.version);
     ffStrbufInit(&board.serial);
 
-    const char* error = ffDetectBoard(&board);
+    const char* error = detectBoard(options, &board);
 
     if (error)
     {
@@ -125,6 +166,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print motherboard name and other info",
     .parseCommandOptions = (void*) ffParseBoardCommandOptions,
     .parseJsonObject = (void*) ffParseBoardJsonObject,
+    .detectModule = (void*) ffDetectBoardModule,
     .printModule = (void*) ffPrintBoard,
     .generateJsonResult = (void*) ffGenerateBoardJsonResult,
     .generateJsonConfig = (void*) ffGenerateBoardJsonConfig,
@@ -1,17 +1,54 @@
 #include "common/printing.h"
+#include "common/cache.h"
 #include "common/jsonconfig.h"
 #include "detection/bootmgr/bootmgr.h"
 #include "modules/bootmgr/bootmgr.h"
 #include "util/stringUtils.h"
 
-void ffPrintBootmgr(FFBootmgrOptions* options)
+static FFBootmgrResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const FFCacheField cacheFields[] = {
+    FF_CACHE_FIELD(FFBootmgrResult, name),
+    FF_CACHE_FIELD(FFBootmgrResult, firmware),
+    FF_CACHE_FIELD(FFBootmgrResult, order),
+    FF_CACHE_FIELD(FFBootmgrResult, secureBoot),
+};
+
+static const char* detectBootmgr(FF_MAYBE_UNUSED FFBootmgrOptions* options, FFBootmgrResult* result)
 {
-    FFBootmgrResult bootmgr = {
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    *result = (FFBootmgrResult) {
         .name = ffStrbufCreate(),
         .firmware = ffStrbufCreate(),
     };
 
-    const char* error = ffDetectBootmgr(&bootmgr);
+    if (ffCacheLoadResult(FF_BOOTMGR_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result))
+        return NULL;
+
+    const char* error = ffDetectBootmgr(result);
+    if (!error)
+        ffCacheSaveResult(FF_BOOTMGR_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result);
+    return error;
+}
+
+void ffDetectBootmgrModule(FFBootmgrOptions* options)
+{
+    detectedError = detectBootmgr(options, &detectedResult);
+    detected = true;
+}
+
+void ffPrintBootmgr(FFBootmgrOptions* options)
+{
+    FFBootmgrResult bootmgr;
+    const char* error = detectBootmgr(options, &bootmgr);
 
     if(error)
     {
@@ -87,12 +124,8 @@ void ffGenerateBootmgrJsonConfig(FFBootmgrOptions* options, yyjson_mut_doc* doc,
 
 void ffGenerateBootmgrJsonResult(FF_MAYBE_UNUSED FFBootmgrOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
-    FFBootmgrResult bootmgr = {
-        .name = ffStrbufCreate(),
-        .firmware = ffStrbufCreate(),
-    };
-
-    const char* error = ffDetectBootmgr(&bootmgr);
+    FFBootmgrResult bootmgr;
+    const char* error = detectBootmgr(options, &bootmgr);
 
     if (error)
     {
@@ -116,6 +149,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print information of 2nd-stage bootloader (name, firmware, etc)",
     .parseCommandOptions = (void*) ffParseBootmgrCommandOptions,
     .parseJsonObject = (void*) ffParseBootmgrJsonObject,
+    .detectModule = (void*) ffDetectBootmgrModule,
     .printModule = (void*) ffPrintBootmgr,
     .generateJsonResult = (void*) ffGenerateBootmgrJsonResult,
     .generateJsonConfig = (void*) ffGenerateBootmgrJsonConfig,
@@ -5,11 +5,34 @@
 #include "modules/brightness/brightness.h"
 #include "util/stringUtils.h"
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectBrightness(FFBrightnessOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectBrightness(options, result);
+}
+
+void ffDetectBrightnessModule(FFBrightnessOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFBrightnessResult));
+    detectedError = detectBrightness(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintBrightness(FFBrightnessOptions* options)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFBrightnessResult));
 
-    const char* error = ffDetectBrightness(options, &result);
+    const char* error = detectBrightness(options, &result);
 
     if(error)
     {
@@ -189,7 +212,7 @@ void ffGenerateBrightnessJsonResult(FF_MAYBE_UNUSED FFBrightnessOptions* options
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFBrightnessResult));
 
-    const char* error = ffDetectBrightness(options, &result);
+    const char* error = detectBrightness(options, &result);
 
     if (error)
     {
@@ -221,6 +244,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print current brightness level of your monitors",
     .parseCommandOptions = (void*) ffParseBrightnessCommandOptions,
     .parseJsonObject = (void*) ffParseBrightnessJsonObject,
+    .detectModule = (void*) ffDetectBrightnessModule,
     .printModule = (void*) ffPrintBrightness,
     .generateJsonResult = (void*) ffGenerateBrightnessJsonResult,
     .generateJsonConfig = (void*) ffGenerateBrightnessJsonConfig,
@@ -96,11 +96,34 @@ static void printBtrfs(FFBtrfsOptions* options, FFBtrfsResult* result, uint8_t i
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectBtrfs(FF_MAYBE_UNUSED FFBtrfsOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectBtrfs(result);
+}
+
+void ffDetectBtrfsModule(FFBtrfsOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFBtrfsResult));
+    detectedError = detectBtrfs(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintBtrfs(FFBtrfsOptions* options)
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFBtrfsResult));
 
-    const char* error = ffDetectBtrfs(&results);
+    const char* error = detectBtrfs(options, &results);
 
     if (error)
     {
@@ -176,7 +199,7 @@ void ffGenerateBtrfsJsonResult(FF_MAYBE_UNUSED FFBtrfsOptions* options, yyjson_m
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFBtrfsResult));
 
-    const char* error = ffDetectBtrfs(&results);
+    const char* error = detectBtrfs(options, &results);
     if (error)
     {
         yyjson_mut_obj_add_str(doc, module, "error", error);
@@ -221,6 +244,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print Linux BTRFS volumes",
     .parseCommandOptions = (void*) ffParseBtrfsCommandOptions,
     .parseJsonObject = (void*) ffParseBtrfsJsonObject,
+    .detectModule = (void*) ffDetectBtrfsModule,
     .printModule = (void*) ffPrintBtrfs,
     .generateJsonResult = (void*) ffGenerateBtrfsJsonResult,
     .generateJsonConfig = (void*) ffGenerateBtrfsJsonConfig,
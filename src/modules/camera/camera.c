@@ -36,10 +36,33 @@ static void printDevice(FFCameraOptions* options, const FFCameraResult* device,
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectCamera(FF_MAYBE_UNUSED FFCameraOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectCamera(result);
+}
+
+void ffDetectCameraModule(FFCameraOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFCameraResult));
+    detectedError = detectCamera(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintCamera(FFCameraOptions* options)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFCameraResult));
-    const char* error = ffDetectCamera(&result);
+    const char* error = detectCamera(options, &result);
 
     if (error)
     {
@@ -105,7 +128,7 @@ void ffGenerateCameraJsonConfig(FFCameraOptions* options, yyjson_mut_doc* doc, y
 void ffGenerateCameraJsonResult(FF_MAYBE_UNUSED FFCameraOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFCameraResult));
-    const char* error = ffDetectCamera(&result);
+    const char* error = detectCamera(options, &result);
 
     if (error)
     {
@@ -139,6 +162,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print available cameras",
     .parseCommandOptions = (void*) ffParseCameraCommandOptions,
     .parseJsonObject = (void*) ffParseCameraJsonObject,
+    .detectModule = (void*) ffDetectCameraModule,
     .printModule = (void*) ffPrintCamera,
     .generateJsonResult = (void*) ffGenerateCameraJsonResult,
     .generateJsonConfig = (void*) ffGenerateCameraJsonConfig,
@@ -1,9 +1,50 @@
 #include "common/printing.h"
+#include "common/cache.h"
 #include "common/jsonconfig.h"
 #include "detection/chassis/chassis.h"
 #include "modules/chassis/chassis.h"
 #include "util/stringUtils.h"
 
+static FFChassisResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const FFCacheField cacheFields[] = {
+    FF_CACHE_FIELD(FFChassisResult, type),
+    FF_CACHE_FIELD(FFChassisResult, serial),
+    FF_CACHE_FIELD(FFChassisResult, vendor),
+    FF_CACHE_FIELD(FFChassisResult, version),
+};
+
+static const char* detectChassis(FF_MAYBE_UNUSED FFChassisOptions* options, FFChassisResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    ffStrbufInit(&result->type);
+    ffStrbufInit(&result->vendor);
+    ffStrbufInit(&result->version);
+    ffStrbufInit(&result->serial);
+
+    if (ffCacheLoadResult(FF_CHASSIS_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result))
+        return NULL;
+
+    const char* error = ffDetectChassis(result);
+    if (!error)
+        ffCacheSaveResult(FF_CHASSIS_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result);
+    return error;
+}
+
+void ffDetectChassisModule(FFChassisOptions* options)
+{
+    detectedError = detectChassis(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintChassis(FFChassisOptions* options)
 {
     FFChassisResult result;
@@ -12,7 +53,7 @@ void ffPrintChassis(FFChassisOptions* options)
     ffStrbufInit(&result.version);
     ffStrbufInit(&result.serial);
 
-    const char* error = ffDetectChassis(&result);
+    const char* error = detectChassis(options, &result);
 
     if(error)
     {
@@ -94,7 +135,7 @@ void ffGenerateChassisJsonResult(FF_MAYBE_UNUSED FFChassisOptions* options, yyjs
     ffStrbufInit(&result.version);
     ffStrbufInit(&result.serial);
 
-    const char* error = ffDetectChassis(&result);
+    const char* error = detectChassis(options, &result);
 
     if (error)
     {
@@ -126,6 +167,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print chassis type (desktop, laptop, etc)",
     .parseCommandOptions = (void*) ffParseChassisCommandOptions,
     .parseJsonObject = (void*) ffParseChassisJsonObject,
+    .detectModule = (void*) ffDetectChassisModule,
     .printModule = (void*) ffPrintChassis,
     .generateJsonResult = (void*) ffGenerateChassisJsonResult,
     .generateJsonConfig = (void*) ffGenerateChassisJsonConfig,
@@ -1,22 +1,109 @@
 #include "common/printing.h"
+#include "common/cache.h"
 #include "common/jsonconfig.h"
 #include "common/processing.h"
 #include "modules/command/command.h"
 #include "util/stringUtils.h"
 
-void ffPrintCommand(FFCommandOptions* options)
+static FFstrbuf detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* runCommand(FFCommandOptions* options, FFstrbuf* result)
 {
-    FF_STRBUF_AUTO_DESTROY result = ffStrbufCreate();
-    const char* error = ffProcessAppendStdOut(&result, options->param.length ? (char* const[]){
+    return ffProcessAppendStdOut(result, options->param.length ? (char* const[]){
+        options->shell.chars,
+        options->param.chars,
+        options->text.chars,
+        NULL
+    } : (char* const[]){
+        options->shell.chars,
+        options->text.chars,
+        NULL
+    });
+}
+
+// Runs the command in a detached process, which replaces the cache entry once the command exits
+static const char* refreshInBackground(FFCommandOptions* options, const FFstrbuf* cachePath)
+{
+    return ffProcessSpawnDetached(options->param.length ? (char* const[]){
+        "/bin/sh",
+        "-c",
+        "f=$1; shift; \"$@\" >\"$f.$$\"; [ $? -ne 127 ] && mv -f \"$f.$$\" \"$f\" || rm -f \"$f.$$\"",
+        "sh",
+        cachePath->chars,
         options->shell.chars,
         options->param.chars,
         options->text.chars,
         NULL
     } : (char* const[]){
+        "/bin/sh",
+        "-c",
+        "f=$1; shift; \"$@\" >\"$f.$$\"; [ $? -ne 127 ] && mv -f \"$f.$$\" \"$f\" || rm -f \"$f.$$\"",
+        "sh",
+        cachePath->chars,
         options->shell.chars,
         options->text.chars,
         NULL
     });
+}
+
+static const char* detectCommand(FFCommandOptions* options, FFstrbuf* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    if (options->cacheTtl == 0)
+        return runCommand(options, result);
+
+    FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
+    ffStrbufAppendNS(&key, options->shell.length + 1, options->shell.chars);
+    ffStrbufAppendNS(&key, options->param.length + 1, options->param.chars);
+    ffStrbufAppendNS(&key, options->text.length + 1, options->text.chars);
+    ffStrbufAppend(&key, &options->cacheKeyFiles);
+
+    FF_STRBUF_AUTO_DESTROY cachePath = ffStrbufCreate();
+    if (!ffCacheGetTtlPath("commands", &key, &cachePath))
+        return runCommand(options, result);
+
+    switch (ffCacheLoadTtl(cachePath.chars, options->cacheTtl, &options->cacheKeyFiles, result))
+    {
+        case FF_CACHE_TTL_FRESH:
+            ffStrbufTrimRightSpace(result);
+            return NULL;
+        case FF_CACHE_TTL_STALE:
+            if (options->cacheStaleWhileRevalidate && refreshInBackground(options, &cachePath) == NULL)
+            {
+                ffStrbufTrimRightSpace(result);
+                return NULL;
+            }
+            ffStrbufClear(result);
+            break;
+        case FF_CACHE_TTL_MISSING:
+            break;
+    }
+
+    const char* error = runCommand(options, result);
+    if (!error)
+        ffCacheSaveTtl(cachePath.chars, result);
+    return error;
+}
+
+void ffDetectCommandModule(FFCommandOptions* options)
+{
+    ffStrbufInit(&detectedResult);
+    detectedError = detectCommand(options, &detectedResult);
+    detected = true;
+}
+
+void ffPrintCommand(FFCommandOptions* options)
+{
+    FF_STRBUF_AUTO_DESTROY result = ffStrbufCreate();
+    const char* error = detectCommand(options, &result);
 
     if(error)
     {
@@ -68,6 +155,24 @@ bool ffParseCommandCommandOptions(FFCommandOptions* options, const char* key, co
         return true;
     }
 
+    if(ffStrEqualsIgnCase(subKey, "cache-ttl"))
+    {
+        options->cacheTtl = ffOptionParseUInt32(key, value);
+        return true;
+    }
+
+    if(ffStrEqualsIgnCase(subKey, "cache-key-files"))
+    {
+        ffOptionParseString(key, value, &options->cacheKeyFiles);
+        return true;
+    }
+
+    if(ffStrEqualsIgnCase(subKey, "cache-stale-while-revalidate"))
+    {
+        options->cacheStaleWhileRevalidate = ffOptionParseBoolean(value);
+        return true;
+    }
+
     return false;
 }
 
@@ -102,6 +207,24 @@ void ffParseCommandJsonObject(FFCommandOptions* options, yyjson_val* module)
             continue;
         }
 
+        if (ffStrEqualsIgnCase(key, "cacheTtl"))
+        {
+            options->cacheTtl = (uint32_t) yyjson_get_uint(val);
+            continue;
+        }
+
+        if (ffStrEqualsIgnCase(key, "cacheKeyFiles"))
+        {
+            ffStrbufSetS(&options->cacheKeyFiles, yyjson_get_str(val));
+            continue;
+        }
+
+        if (ffStrEqualsIgnCase(key, "cacheStaleWhileRevalidate"))
+        {
+            options->cacheStaleWhileRevalidate = yyjson_get_bool(val);
+            continue;
+        }
+
         ffPrintError(FF_COMMAND_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "Unknown JSON key %s", key);
     }
 }
@@ -121,21 +244,21 @@ void ffGenerateCommandJsonConfig(FFCommandOptions* options, yyjson_mut_doc* doc,
 
     if (!ffStrbufEqual(&defaultOptions.text, &options->text))
         yyjson_mut_obj_add_strbuf(doc, module, "text", &options->text);
+
+    if (defaultOptions.cacheTtl != options->cacheTtl)
+        yyjson_mut_obj_add_uint(doc, module, "cacheTtl", options->cacheTtl);
+
+    if (!ffStrbufEqual(&defaultOptions.cacheKeyFiles, &options->cacheKeyFiles))
+        yyjson_mut_obj_add_strbuf(doc, module, "cacheKeyFiles", &options->cacheKeyFiles);
+
+    if (defaultOptions.cacheStaleWhileRevalidate != options->cacheStaleWhileRevalidate)
+        yyjson_mut_obj_add_bool(doc, module, "cacheStaleWhileRevalidate", options->cacheStaleWhileRevalidate);
 }
 
 void ffGenerateCommandJsonResult(FF_MAYBE_UNUSED FFCommandOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_STRBUF_AUTO_DESTROY result = ffStrbufCreate();
-    const char* error = ffProcessAppendStdOut(&result, options->param.length ? (char* const[]){
-        options->shell.chars,
-        options->param.chars,
-        options->text.chars,
-        NULL
-    } : (char* const[]){
-        options->shell.chars,
-        options->text.chars,
-        NULL
-    });
+    const char* error = detectCommand(options, &result);
 
     if(error)
     {
@@ -157,6 +280,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Run custom shell scripts",
     .parseCommandOptions = (void*) ffParseCommandCommandOptions,
     .parseJsonObject = (void*) ffParseCommandJsonObject,
+    .detectModule = (void*) ffDetectCommandModule,
     .printModule = (void*) ffPrintCommand,
     .generateJsonResult = (void*) ffGenerateCommandJsonResult,
     .generateJsonConfig = (void*) ffGenerateCommandJsonConfig,
@@ -185,6 +309,9 @@ void ffInitCommandOptions(FFCommandOptions* options)
         #endif
     );
     ffStrbufInit(&options->text);
+    options->cacheTtl = 0;
+    ffStrbufInit(&options->cacheKeyFiles);
+    options->cacheStaleWhileRevalidate = false;
 }
 
 void ffDestroyCommandOptions(FFCommandOptions* options)
@@ -193,4 +320,5 @@ void ffDestroyCommandOptions(FFCommandOptions* options)
     ffStrbufDestroy(&options->shell);
     ffStrbufDestroy(&options->param);
     ffStrbufDestroy(&options->text);
+    ffStrbufDestroy(&options->cacheKeyFiles);
 }
@@ -12,4 +12,7 @@ typedef struct FFCommandOptions
     FFstrbuf shell;
     FFstrbuf param;
     FFstrbuf text;
+    uint32_t cacheTtl; // In seconds. 0 to disable the cache
+    FFstrbuf cacheKeyFiles;
+    bool cacheStaleWhileRevalidate;
 } FFCommandOptions;
@@ -1,4 +1,5 @@
 #include "common/printing.h"
+#include "common/cache.h"
 #include "common/jsonconfig.h"
 #include "common/parsing.h"
 #include "common/temps.h"
@@ -11,9 +12,32 @@ static int sortCores(const FFCPUCore* a, const FFCPUCore* b)
     return (int)b->freq - (int)a->freq;
 }
 
-void ffPrintCPU(FFCPUOptions* options)
+static FFCPUResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const FFCacheField cacheFields[] = {
+    FF_CACHE_FIELD(FFCPUResult, name),
+    FF_CACHE_FIELD(FFCPUResult, vendor),
+    FF_CACHE_FIELD(FFCPUResult, packages),
+    FF_CACHE_FIELD(FFCPUResult, coresPhysical),
+    FF_CACHE_FIELD(FFCPUResult, coresLogical),
+    FF_CACHE_FIELD(FFCPUResult, coresOnline),
+    FF_CACHE_FIELD(FFCPUResult, frequencyBase),
+    FF_CACHE_FIELD(FFCPUResult, frequencyMax),
+    FF_CACHE_FIELD(FFCPUResult, coreTypes),
+};
+
+static const char* detectCPU(FFCPUOptions* options, FFCPUResult* cpu)
 {
-    FFCPUResult cpu = {
+    if (detected)
+    {
+        detected = false;
+        *cpu = detectedResult;
+        return detectedError;
+    }
+
+    *cpu = (FFCPUResult) {
         .temperature = FF_CPU_TEMP_UNSET,
         .frequencyMax = 0,
         .frequencyBase = 0,
@@ -21,7 +45,29 @@ void ffPrintCPU(FFCPUOptions* options)
         .vendor = ffStrbufCreate(),
     };
 
-    const char* error = ffDetectCPU(options, &cpu);
+    // Temperatures change all the time
+    if (options->temp)
+        return ffDetectCPU(options, cpu);
+
+    if (ffCacheLoadResult(FF_CPU_MODULE_NAME, &options->showPeCoreCount, sizeof(options->showPeCoreCount), cacheFields, ARRAY_SIZE(cacheFields), cpu))
+        return NULL;
+
+    const char* error = ffDetectCPU(options, cpu);
+    if (!error)
+        ffCacheSaveResult(FF_CPU_MODULE_NAME, &options->showPeCoreCount, sizeof(options->showPeCoreCount), cacheFields, ARRAY_SIZE(cacheFields), cpu);
+    return error;
+}
+
+void ffDetectCPUModule(FFCPUOptions* options)
+{
+    detectedError = detectCPU(options, &detectedResult);
+    detected = true;
+}
+
+void ffPrintCPU(FFCPUOptions* options)
+{
+    FFCPUResult cpu;
+    const char* error = detectCPU(options, &cpu);
 
     if(error)
     {
@@ -182,15 +228,8 @@ void ffGenerateCPUJsonConfig(FFCPUOptions* options, yyjson_mut_doc* doc, yyjson_
 
 void ffGenerateCPUJsonResult(FFCPUOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
-    FFCPUResult cpu = {
-        .temperature = FF_CPU_TEMP_UNSET,
-        .frequencyMax = 0,
-        .frequencyBase = 0,
-        .name = ffStrbufCreate(),
-        .vendor = ffStrbufCreate(),
-    };
-
-    const char* error = ffDetectCPU(options, &cpu);
+    FFCPUResult cpu;
+    const char* error = detectCPU(options, &cpu);
 
     if(error)
     {
@@ -239,6 +278,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print CPU name, frequency, etc",
     .parseCommandOptions = (void*) ffParseCPUCommandOptions,
     .parseJsonObject = (void*) ffParseCPUJsonObject,
+    .detectModule = (void*) ffDetectCPUModule,
     .printModule = (void*) ffPrintCPU,
     .generateJsonResult = (void*) ffGenerateCPUJsonResult,
     .generateJsonConfig = (void*) ffGenerateCPUJsonConfig,
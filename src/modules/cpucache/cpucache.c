@@ -100,6 +100,36 @@ static void printCPUCacheCompact(const FFCPUCacheResult* result, FFCPUCacheOptio
     }
 }
 
+static FFCPUCacheResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectCPUCache(FF_MAYBE_UNUSED FFCPUCacheOptions* options, FFCPUCacheResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    *result = (FFCPUCacheResult) {
+        .caches = {
+            ffListCreate(sizeof(FFCPUCache)),
+            ffListCreate(sizeof(FFCPUCache)),
+            ffListCreate(sizeof(FFCPUCache)),
+            ffListCreate(sizeof(FFCPUCache)),
+        },
+    };
+    return ffDetectCPUCache(result);
+}
+
+void ffDetectCPUCacheModule(FFCPUCacheOptions* options)
+{
+    detectedError = detectCPUCache(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintCPUCache(FFCPUCacheOptions* options)
 {
     FFCPUCacheResult result = {
@@ -111,7 +141,7 @@ void ffPrintCPUCache(FFCPUCacheOptions* options)
         },
     };
 
-    const char* error = ffDetectCPUCache(&result);
+    const char* error = detectCPUCache(options, &result);
 
     if(error)
     {
@@ -189,7 +219,7 @@ void ffGenerateCPUCacheJsonResult(FF_MAYBE_UNUSED FFCPUCacheOptions* options, yy
         },
     };
 
-    const char* error = ffDetectCPUCache(&result);
+    const char* error = detectCPUCache(options, &result);
 
     if (error)
     {
@@ -232,6 +262,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print CPU cache sizes",
     .parseCommandOptions = (void*) ffParseCPUCacheCommandOptions,
     .parseJsonObject = (void*) ffParseCPUCacheJsonObject,
+    .detectModule = (void*) ffDetectCPUCacheModule,
     .printModule = (void*) ffPrintCPUCache,
     .generateJsonResult = (void*) ffGenerateCPUCacheJsonResult,
     .generateJsonConfig = (void*) ffGenerateCPUCacheJsonConfig,
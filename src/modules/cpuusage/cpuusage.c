@@ -7,10 +7,33 @@
 
 #define FF_CPUUSAGE_DISPLAY_NAME "CPU Usage"
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectCPUUsage(FFCPUUsageOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffGetCpuUsageResult(options, result);
+}
+
+void ffDetectCPUUsageModule(FFCPUUsageOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(double));
+    detectedError = detectCPUUsage(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintCPUUsage(FFCPUUsageOptions* options)
 {
     FF_LIST_AUTO_DESTROY percentages = ffListCreate(sizeof(double));
-    const char* error = ffGetCpuUsageResult(options, &percentages);
+    const char* error = detectCPUUsage(options, &percentages);
 
     if(error)
     {
@@ -179,7 +202,7 @@ void ffGenerateCPUUsageJsonConfig(FFCPUUsageOptions* options, yyjson_mut_doc* do
 void ffGenerateCPUUsageJsonResult(FFCPUUsageOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_LIST_AUTO_DESTROY percentages = ffListCreate(sizeof(double));
-    const char* error = ffGetCpuUsageResult(options, &percentages);
+    const char* error = detectCPUUsage(options, &percentages);
 
     if(error)
     {
@@ -198,6 +221,8 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print CPU usage. Costs some time to collect data",
     .parseCommandOptions = (void*) ffParseCPUUsageCommandOptions,
     .parseJsonObject = (void*) ffParseCPUUsageJsonObject,
+    .prepareModule = (void*) ffPrepareCPUUsage,
+    .detectModule = (void*) ffDetectCPUUsageModule,
     .printModule = (void*) ffPrintCPUUsage,
     .generateJsonResult = (void*) ffGenerateCPUUsageJsonResult,
     .generateJsonConfig = (void*) ffGenerateCPUUsageJsonConfig,
@@ -4,7 +4,7 @@
 
 #define FF_CPUUSAGE_MODULE_NAME "CPUUsage"
 
-void ffPrepareCPUUsage();
+void ffPrepareCPUUsage(FFCPUUsageOptions* options);
 
 void ffPrintCPUUsage(FFCPUUsageOptions* options);
 void ffInitCPUUsageOptions(FFCPUUsageOptions* options);
@@ -5,6 +5,12 @@
 #include "modules/de/de.h"
 #include "util/stringUtils.h"
 
+void ffDetectDEModule(FF_MAYBE_UNUSED FFDEOptions* options)
+{
+    // The result is memoized and shared with printing
+    ffConnectDisplayServer();
+}
+
 void ffPrintDE(FFDEOptions* options)
 {
     const FFDisplayServerResult* result = ffConnectDisplayServer();
@@ -116,6 +122,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print desktop environment name",
     .parseCommandOptions = (void*) ffParseDECommandOptions,
     .parseJsonObject = (void*) ffParseDEJsonObject,
+    .detectModule = (void*) ffDetectDEModule,
     .printModule = (void*) ffPrintDE,
     .generateJsonResult = (void*) ffGenerateDEJsonResult,
     .generateJsonConfig = (void*) ffGenerateDEJsonConfig,
@@ -162,10 +162,33 @@ static void printDisk(FFDiskOptions* options, const FFDisk* disk, uint32_t index
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectDisk(FFDiskOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectDisks(options, result);
+}
+
+void ffDetectDiskModule(FFDiskOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFDisk));
+    detectedError = detectDisk(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintDisk(FFDiskOptions* options)
 {
     FF_LIST_AUTO_DESTROY disks = ffListCreate(sizeof (FFDisk));
-    const char* error = ffDetectDisks(options, &disks);
+    const char* error = detectDisk(options, &disks);
 
     if(error)
     {
@@ -391,7 +414,7 @@ void ffGenerateDiskJsonConfig(FFDiskOptions* options, yyjson_mut_doc* doc, yyjso
 void ffGenerateDiskJsonResult(FFDiskOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_LIST_AUTO_DESTROY disks = ffListCreate(sizeof (FFDisk));
-    const char* error = ffDetectDisks(options, &disks);
+    const char* error = detectDisk(options, &disks);
 
     if(error)
     {
@@ -462,6 +485,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print partitions, space usage, file system, etc",
     .parseCommandOptions = (void*) ffParseDiskCommandOptions,
     .parseJsonObject = (void*) ffParseDiskJsonObject,
+    .detectModule = (void*) ffDetectDiskModule,
     .printModule = (void*) ffPrintDisk,
     .generateJsonResult = (void*) ffGenerateDiskJsonResult,
     .generateJsonConfig = (void*) ffGenerateDiskJsonConfig,
@@ -30,10 +30,33 @@ static void formatKey(const FFDiskIOOptions* options, FFDiskIOResult* dev, uint3
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectDiskIO(FFDiskIOOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectDiskIO(result, options);
+}
+
+void ffDetectDiskIOModule(FFDiskIOOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFDiskIOResult));
+    detectedError = detectDiskIO(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintDiskIO(FFDiskIOOptions* options)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFDiskIOResult));
-    const char* error = ffDetectDiskIO(&result, options);
+    const char* error = detectDiskIO(options, &result);
 
     if(error)
     {
@@ -175,7 +198,7 @@ void ffGenerateDiskIOJsonConfig(FFDiskIOOptions* options, yyjson_mut_doc* doc, y
 void ffGenerateDiskIOJsonResult(FFDiskIOOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFDiskIOResult));
-    const char* error = ffDetectDiskIO(&result, options);
+    const char* error = detectDiskIO(options, &result);
 
     if(error)
     {
@@ -207,6 +230,8 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print physical disk I/O throughput",
     .parseCommandOptions = (void*) ffParseDiskIOCommandOptions,
     .parseJsonObject = (void*) ffParseDiskIOJsonObject,
+    .prepareModule = (void*) ffPrepareDiskIO,
+    .detectModule = (void*) ffDetectDiskIOModule,
     .printModule = (void*) ffPrintDiskIO,
     .generateJsonResult = (void*) ffGenerateDiskIOJsonResult,
     .generateJsonConfig = (void*) ffGenerateDiskIOJsonConfig,
@@ -16,6 +16,12 @@ static int sortByNameDesc(FFDisplayResult* a, FFDisplayResult* b)
     return -ffStrbufComp(&a->name, &b->name);
 }
 
+void ffDetectDisplayModule(FF_MAYBE_UNUSED FFDisplayOptions* options)
+{
+    // The result is memoized and shared with printing
+    ffConnectDisplayServer();
+}
+
 void ffPrintDisplay(FFDisplayOptions* options)
 {
     const FFDisplayServerResult* dsResult = ffConnectDisplayServer();
@@ -438,6 +444,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print resolutions, refresh rates, etc",
     .parseCommandOptions = (void*) ffParseDisplayCommandOptions,
     .parseJsonObject = (void*) ffParseDisplayJsonObject,
+    .detectModule = (void*) ffDetectDisplayModule,
     .printModule = (void*) ffPrintDisplay,
     .generateJsonResult = (void*) ffGenerateDisplayJsonResult,
     .generateJsonConfig = (void*) ffGenerateDisplayJsonConfig,
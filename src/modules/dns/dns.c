@@ -4,11 +4,34 @@
 #include "modules/dns/dns.h"
 #include "util/stringUtils.h"
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectDNS(FFDNSOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectDNS(options, result);
+}
+
+void ffDetectDNSModule(FFDNSOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFstrbuf));
+    detectedError = detectDNS(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintDNS(FFDNSOptions* options)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFstrbuf));
 
-    const char* error = ffDetectDNS(options, &result);
+    const char* error = detectDNS(options, &result);
 
     if (error)
     {
@@ -142,7 +165,7 @@ void ffGenerateDNSJsonResult(FF_MAYBE_UNUSED FFDNSOptions* options, yyjson_mut_d
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFstrbuf));
 
-    const char* error = ffDetectDNS(options, &result);
+    const char* error = detectDNS(options, &result);
 
     if (error)
     {
@@ -169,6 +192,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print configured DNS servers",
     .parseCommandOptions = (void*) ffParseDNSCommandOptions,
     .parseJsonObject = (void*) ffParseDNSJsonObject,
+    .detectModule = (void*) ffDetectDNSModule,
     .printModule = (void*) ffPrintDNS,
     .generateJsonResult = (void*) ffGenerateDNSJsonResult,
     .generateJsonConfig = (void*) ffGenerateDNSJsonConfig,
@@ -5,16 +5,39 @@
 #include "modules/editor/editor.h"
 #include "util/stringUtils.h"
 
-void ffPrintEditor(FFEditorOptions* options)
+static FFEditorResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectEditor(FF_MAYBE_UNUSED FFEditorOptions* options, FFEditorResult* result)
 {
-    FFEditorResult result = {
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    *result = (FFEditorResult) {
         .type = "Unknown",
         .name = ffStrbufCreate(),
         .path = ffStrbufCreate(),
         .exe = ffStrbufCreate(),
         .version = ffStrbufCreate(),
     };
-    const char* error = ffDetectEditor(&result);
+    return ffDetectEditor(result);
+}
+
+void ffDetectEditorModule(FFEditorOptions* options)
+{
+    detectedError = detectEditor(options, &detectedResult);
+    detected = true;
+}
+
+void ffPrintEditor(FFEditorOptions* options)
+{
+    FFEditorResult result;
+    const char* error = detectEditor(options, &result);
 
     if (error)
     {
@@ -91,13 +114,8 @@ void ffGenerateEditorJsonConfig(FFEditorOptions* options, yyjson_mut_doc* doc, y
 
 void ffGenerateEditorJsonResult(FF_MAYBE_UNUSED FFEditorOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
-    FFEditorResult result = {
-        .name = ffStrbufCreate(),
-        .path = ffStrbufCreate(),
-        .version = ffStrbufCreate(),
-    };
-
-    const char* error = ffDetectEditor(&result);
+    FFEditorResult result;
+    const char* error = detectEditor(options, &result);
 
     if (error)
     {
@@ -123,6 +141,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print information of the default editor ($VISUAL or $EDITOR)",
     .parseCommandOptions = (void*) ffParseEditorCommandOptions,
     .parseJsonObject = (void*) ffParseEditorJsonObject,
+    .detectModule = (void*) ffDetectEditorModule,
     .printModule = (void*) ffPrintEditor,
     .generateJsonResult = (void*) ffGenerateEditorJsonResult,
     .generateJsonConfig = (void*) ffGenerateEditorJsonConfig,
@@ -4,6 +4,31 @@
 #include "modules/font/font.h"
 #include "util/stringUtils.h"
 
+static FFFontResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectFont(FF_MAYBE_UNUSED FFFontOptions* options, FFFontResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    for(uint32_t i = 0; i < FF_DETECT_FONT_NUM_FONTS; ++i)
+        ffStrbufInit(&result->fonts[i]);
+    ffStrbufInit(&result->display);
+    return ffDetectFont(result);
+}
+
+void ffDetectFontModule(FFFontOptions* options)
+{
+    detectedError = detectFont(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintFont(FFFontOptions* options)
 {
     FFFontResult font;
@@ -11,7 +36,7 @@ void ffPrintFont(FFFontOptions* options)
         ffStrbufInit(&font.fonts[i]);
     ffStrbufInit(&font.display);
 
-    const char* error = ffDetectFont(&font);
+    const char* error = detectFont(options, &font);
 
     if(error)
     {
@@ -83,7 +108,7 @@ void ffGenerateFontJsonResult(FF_MAYBE_UNUSED FFFontOptions* options, yyjson_mut
         ffStrbufInit(&font.fonts[i]);
     ffStrbufInit(&font.display);
 
-    const char* error = ffDetectFont(&font);
+    const char* error = detectFont(options, &font);
     if(error)
     {
         yyjson_mut_obj_add_str(doc, module, "error", error);
@@ -107,6 +132,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print system font names",
     .parseCommandOptions = (void*) ffParseFontCommandOptions,
     .parseJsonObject = (void*) ffParseFontJsonObject,
+    .detectModule = (void*) ffDetectFontModule,
     .printModule = (void*) ffPrintFont,
     .generateJsonResult = (void*) ffGenerateFontJsonResult,
     .generateJsonConfig = (void*) ffGenerateFontJsonConfig,
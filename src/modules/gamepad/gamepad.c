@@ -50,11 +50,34 @@ static void printDevice(FFGamepadOptions* options, const FFGamepadDevice* device
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectGamepad(FF_MAYBE_UNUSED FFGamepadOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectGamepad(result);
+}
+
+void ffDetectGamepadModule(FFGamepadOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFGamepadDevice));
+    detectedError = detectGamepad(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintGamepad(FFGamepadOptions* options)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFGamepadDevice));
 
-    const char* error = ffDetectGamepad(&result);
+    const char* error = detectGamepad(options, &result);
 
     if(error)
     {
@@ -124,7 +147,7 @@ void ffGenerateGamepadJsonResult(FF_MAYBE_UNUSED FFGamepadOptions* options, yyjs
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFGamepadDevice));
 
-    const char* error = ffDetectGamepad(&result);
+    const char* error = detectGamepad(options, &result);
 
     if(error)
     {
@@ -152,6 +175,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "List (connected) gamepads",
     .parseCommandOptions = (void*) ffParseGamepadCommandOptions,
     .parseJsonObject = (void*) ffParseGamepadJsonObject,
+    .detectModule = (void*) ffDetectGamepadModule,
     .printModule = (void*) ffPrintGamepad,
     .generateJsonResult = (void*) ffGenerateGamepadJsonResult,
     .generateJsonConfig = (void*) ffGenerateGamepadJsonConfig,
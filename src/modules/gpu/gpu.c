@@ -1,6 +1,7 @@
 #include "common/percent.h"
 #include "common/parsing.h"
 #include "common/printing.h"
+#include "common/cache.h"
 #include "common/jsonconfig.h"
 #include "common/temps.h"
 #include "detection/host/host.h"
@@ -158,10 +159,73 @@ static void printGPUResult(FFGPUOptions* options, uint8_t index, const FFGPUResu
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const FFCacheField cacheFields[] = {
+    FF_CACHE_FIELD(FFGPUResult, index),
+    FF_CACHE_FIELD(FFGPUResult, type),
+    FF_CACHE_FIELD(FFGPUResult, vendor),
+    FF_CACHE_FIELD(FFGPUResult, name),
+    FF_CACHE_FIELD(FFGPUResult, driver),
+    FF_CACHE_FIELD(FFGPUResult, platformApi),
+    FF_CACHE_FIELD(FFGPUResult, memoryType),
+    FF_CACHE_FIELD(FFGPUResult, temperature),
+    FF_CACHE_FIELD(FFGPUResult, coreUsage),
+    FF_CACHE_FIELD(FFGPUResult, coreCount),
+    FF_CACHE_FIELD(FFGPUResult, frequency),
+    FF_CACHE_FIELD(FFGPUResult, dedicated),
+    FF_CACHE_FIELD(FFGPUResult, shared),
+    FF_CACHE_FIELD(FFGPUResult, deviceId),
+};
+
+// Options that affect the detected GPU list
+typedef struct FFGPUCacheKey
+{
+    FFGPUDetectionMethod detectionMethod;
+    FFGPUType hideType;
+    bool forceMethod;
+} FFGPUCacheKey;
+
+static const char* detectGPU(FFGPUOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    // Temperatures and usages that come with driver specific info change all the time
+    if (options->temp || options->driverSpecific)
+        return ffDetectGPU(options, result);
+
+    FFGPUCacheKey key = {
+        .detectionMethod = options->detectionMethod,
+        .hideType = options->hideType,
+        .forceMethod = options->forceMethod,
+    };
+    if (ffCacheLoadResultList(FF_GPU_MODULE_NAME, &key, sizeof(key), cacheFields, ARRAY_SIZE(cacheFields), result))
+        return NULL;
+
+    const char* error = ffDetectGPU(options, result);
+    if (!error)
+        ffCacheSaveResultList(FF_GPU_MODULE_NAME, &key, sizeof(key), cacheFields, ARRAY_SIZE(cacheFields), result);
+    return error;
+}
+
+void ffDetectGPUModule(FFGPUOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFGPUResult));
+    detectedError = detectGPU(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintGPU(FFGPUOptions* options)
 {
     FF_LIST_AUTO_DESTROY gpus = ffListCreate(sizeof (FFGPUResult));
-    const char* error = ffDetectGPU(options, &gpus);
+    const char* error = detectGPU(options, &gpus);
     if (error)
     {
         ffPrintError(FF_GPU_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
@@ -363,7 +427,7 @@ void ffGenerateGPUJsonConfig(FFGPUOptions* options, yyjson_mut_doc* doc, yyjson_
 void ffGenerateGPUJsonResult(FFGPUOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_LIST_AUTO_DESTROY gpus = ffListCreate(sizeof (FFGPUResult));
-    const char* error = ffDetectGPU(options, &gpus);
+    const char* error = detectGPU(options, &gpus);
     if (error)
     {
         yyjson_mut_obj_add_str(doc, module, "error", error);
@@ -456,6 +520,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print GPU names, graphic memory size, type, etc",
     .parseCommandOptions = (void*) ffParseGPUCommandOptions,
     .parseJsonObject = (void*) ffParseGPUJsonObject,
+    .detectModule = (void*) ffDetectGPUModule,
     .printModule = (void*) ffPrintGPU,
     .generateJsonResult = (void*) ffGenerateGPUJsonResult,
     .generateJsonConfig = (void*) ffGenerateGPUJsonConfig,
@@ -1,21 +1,60 @@
 #include "common/printing.h"
+#include "common/cache.h"
 #include "common/jsonconfig.h"
 #include "detection/host/host.h"
 #include "modules/host/host.h"
 #include "util/stringUtils.h"
 
+static FFHostResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const FFCacheField cacheFields[] = {
+    FF_CACHE_FIELD(FFHostResult, family),
+    FF_CACHE_FIELD(FFHostResult, name),
+    FF_CACHE_FIELD(FFHostResult, version),
+    FF_CACHE_FIELD(FFHostResult, sku),
+    FF_CACHE_FIELD(FFHostResult, serial),
+    FF_CACHE_FIELD(FFHostResult, uuid),
+    FF_CACHE_FIELD(FFHostResult, vendor),
+};
+
+static const char* detectHost(FF_MAYBE_UNUSED FFHostOptions* options, FFHostResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    ffStrbufInit(&result->family);
+    ffStrbufInit(&result->name);
+    ffStrbufInit(&result->version);
+    ffStrbufInit(&result->sku);
+    ffStrbufInit(&result->serial);
+    ffStrbufInit(&result->uuid);
+    ffStrbufInit(&result->vendor);
+
+    if (ffCacheLoadResult(FF_HOST_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result))
+        return NULL;
+
+    const char* error = ffDetectHost(result);
+    if (!error)
+        ffCacheSaveResult(FF_HOST_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result);
+    return error;
+}
+
+void ffDetectHostModule(FFHostOptions* options)
+{
+    detectedError = detectHost(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintHost(FFHostOptions* options)
 {
     FFHostResult host;
-    ffStrbufInit(&host.family);
-    ffStrbufInit(&host.name);
-    ffStrbufInit(&host.version);
-    ffStrbufInit(&host.sku);
-    ffStrbufInit(&host.serial);
-    ffStrbufInit(&host.uuid);
-    ffStrbufInit(&host.vendor);
-
-    const char* error = ffDetectHost(&host);
+    const char* error = detectHost(options, &host);
     if(error)
     {
         ffPrintError(FF_HOST_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
@@ -105,15 +144,7 @@ void ffGenerateHostJsonConfig(FFHostOptions* options, yyjson_mut_doc* doc, yyjso
 void ffGenerateHostJsonResult(FF_MAYBE_UNUSED FFHostOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FFHostResult host;
-    ffStrbufInit(&host.family);
-    ffStrbufInit(&host.name);
-    ffStrbufInit(&host.version);
-    ffStrbufInit(&host.sku);
-    ffStrbufInit(&host.serial);
-    ffStrbufInit(&host.uuid);
-    ffStrbufInit(&host.vendor);
-
-    const char* error = ffDetectHost(&host);
+    const char* error = detectHost(options, &host);
     if (error)
     {
         yyjson_mut_obj_add_str(doc, module, "error", error);
@@ -150,6 +181,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print product name of your computer",
     .parseCommandOptions = (void*) ffParseHostCommandOptions,
     .parseJsonObject = (void*) ffParseHostJsonObject,
+    .detectModule = (void*) ffDetectHostModule,
     .printModule = (void*) ffPrintHost,
     .generateJsonResult = (void*) ffGenerateHostJsonResult,
     .generateJsonConfig = (void*) ffGenerateHostJsonConfig,
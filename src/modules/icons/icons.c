@@ -4,13 +4,39 @@
 #include "modules/icons/icons.h"
 #include "util/stringUtils.h"
 
+static FFIconsResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectIcons(FF_MAYBE_UNUSED FFIconsOptions* options, FFIconsResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    *result = (FFIconsResult) {
+        .icons1 = ffStrbufCreate(),
+        .icons2 = ffStrbufCreate(),
+    };
+    return ffDetectIcons(result);
+}
+
+void ffDetectIconsModule(FFIconsOptions* options)
+{
+    detectedError = detectIcons(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintIcons(FFIconsOptions* options)
 {
     FFIconsResult result = {
         .icons1 = ffStrbufCreate(),
         .icons2 = ffStrbufCreate(),
     };
-    const char* error = ffDetectIcons(&result);
+    const char* error = detectIcons(options, &result);
 
     if(error)
     {
@@ -84,7 +110,7 @@ void ffGenerateIconsJsonResult(FF_MAYBE_UNUSED FFIconsOptions* options, yyjson_m
         .icons1 = ffStrbufCreate(),
         .icons2 = ffStrbufCreate()
     };
-    const char* error = ffDetectIcons(&result);
+    const char* error = detectIcons(options, &result);
 
     if(error)
     {
@@ -105,6 +131,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print icon style name",
     .parseCommandOptions = (void*) ffParseIconsCommandOptions,
     .parseJsonObject = (void*) ffParseIconsJsonObject,
+    .detectModule = (void*) ffDetectIconsModule,
     .printModule = (void*) ffPrintIcons,
     .generateJsonResult = (void*) ffGenerateIconsJsonResult,
     .generateJsonConfig = (void*) ffGenerateIconsJsonConfig,
@@ -6,16 +6,38 @@
 
 #define FF_INITSYSTEM_DISPLAY_NAME "Init System"
 
-void ffPrintInitSystem(FFInitSystemOptions* options)
+static FFInitSystemResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectInitSystem(FF_MAYBE_UNUSED FFInitSystemOptions* options, FFInitSystemResult* result)
 {
-    FFInitSystemResult result = {
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    *result = (FFInitSystemResult) {
         .name = ffStrbufCreate(),
         .exe = ffStrbufCreate(),
         .version = ffStrbufCreate(),
         .pid = 1,
     };
+    return ffDetectInitSystem(result);
+}
 
-    const char* error = ffDetectInitSystem(&result);
+void ffDetectInitSystemModule(FFInitSystemOptions* options)
+{
+    detectedError = detectInitSystem(options, &detectedResult);
+    detected = true;
+}
+
+void ffPrintInitSystem(FFInitSystemOptions* options)
+{
+    FFInitSystemResult result;
+    const char* error = detectInitSystem(options, &result);
 
     if(error)
     {
@@ -85,14 +107,8 @@ void ffGenerateInitSystemJsonConfig(FFInitSystemOptions* options, yyjson_mut_doc
 
 void ffGenerateInitSystemJsonResult(FF_MAYBE_UNUSED FFInitSystemOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
-    FFInitSystemResult result = {
-        .name = ffStrbufCreate(),
-        .exe = ffStrbufCreate(),
-        .version = ffStrbufCreate(),
-        .pid = 1,
-    };
-
-    const char* error = ffDetectInitSystem(&result);
+    FFInitSystemResult result;
+    const char* error = detectInitSystem(options, &result);
 
     if (error)
     {
@@ -117,6 +133,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print init system (pid 1) name and version",
     .parseCommandOptions = (void*) ffParseInitSystemCommandOptions,
     .parseJsonObject = (void*) ffParseInitSystemJsonObject,
+    .detectModule = (void*) ffDetectInitSystemModule,
     .printModule = (void*) ffPrintInitSystem,
     .generateJsonResult = (void*) ffGenerateInitSystemJsonResult,
     .generateJsonConfig = (void*) ffGenerateInitSystemJsonConfig,
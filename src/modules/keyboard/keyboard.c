@@ -21,11 +21,34 @@ static void printDevice(FFKeyboardOptions* options, const FFKeyboardDevice* devi
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectKeyboard(FF_MAYBE_UNUSED FFKeyboardOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectKeyboard(result);
+}
+
+void ffDetectKeyboardModule(FFKeyboardOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFKeyboardDevice));
+    detectedError = detectKeyboard(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintKeyboard(FFKeyboardOptions* options)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFKeyboardDevice));
 
-    const char* error = ffDetectKeyboard(&result);
+    const char* error = detectKeyboard(options, &result);
 
     if(error)
     {
@@ -87,7 +110,7 @@ void ffGenerateKeyboardJsonResult(FF_MAYBE_UNUSED FFKeyboardOptions* options, yy
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFKeyboardDevice));
 
-    const char* error = ffDetectKeyboard(&result);
+    const char* error = detectKeyboard(options, &result);
 
     if(error)
     {
@@ -115,6 +138,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "List (connected) keyboards",
     .parseCommandOptions = (void*) ffParseKeyboardCommandOptions,
     .parseJsonObject = (void*) ffParseKeyboardJsonObject,
+    .detectModule = (void*) ffDetectKeyboardModule,
     .printModule = (void*) ffPrintKeyboard,
     .generateJsonResult = (void*) ffGenerateKeyboardJsonResult,
     .generateJsonConfig = (void*) ffGenerateKeyboardJsonConfig,
@@ -4,13 +4,35 @@
 #include "modules/lm/lm.h"
 #include "util/stringUtils.h"
 
+static FFLMResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectLM(FF_MAYBE_UNUSED FFLMOptions* options, FFLMResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    ffStrbufInit(&result->service);
+    ffStrbufInit(&result->type);
+    ffStrbufInit(&result->version);
+    return ffDetectLM(result);
+}
+
+void ffDetectLMModule(FFLMOptions* options)
+{
+    detectedError = detectLM(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintLM(FFLMOptions* options)
 {
     FFLMResult result;
-    ffStrbufInit(&result.service);
-    ffStrbufInit(&result.type);
-    ffStrbufInit(&result.version);
-    const char* error = ffDetectLM(&result);
+    const char* error = detectLM(options, &result);
 
     if(error)
     {
@@ -85,10 +107,7 @@ void ffGenerateLMJsonConfig(FFLMOptions* options, yyjson_mut_doc* doc, yyjson_mu
 void ffGenerateLMJsonResult(FF_MAYBE_UNUSED FFLMOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FFLMResult result;
-    ffStrbufInit(&result.service);
-    ffStrbufInit(&result.type);
-    ffStrbufInit(&result.version);
-    const char* error = ffDetectLM(&result);
+    const char* error = detectLM(options, &result);
 
     if(error)
     {
@@ -118,6 +137,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print login manager (desktop manager) name and version",
     .parseCommandOptions = (void*) ffParseLMCommandOptions,
     .parseJsonObject = (void*) ffParseLMJsonObject,
+    .detectModule = (void*) ffDetectLMModule,
     .printModule = (void*) ffPrintLM,
     .generateJsonResult = (void*) ffGenerateLMJsonResult,
     .generateJsonConfig = (void*) ffGenerateLMJsonConfig,
@@ -86,11 +86,34 @@ static void printIp(FFLocalIpResult* ip, bool markDefaultRoute)
         fputs(" *", stdout);
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectLocalIp(FFLocalIpOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectLocalIps(options, result);
+}
+
+void ffDetectLocalIpModule(FFLocalIpOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFLocalIpResult));
+    detectedError = detectLocalIp(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintLocalIp(FFLocalIpOptions* options)
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFLocalIpResult));
 
-    const char* error = ffDetectLocalIps(options, &results);
+    const char* error = detectLocalIp(options, &results);
 
     if(error)
     {
@@ -461,7 +484,7 @@ void ffGenerateLocalIpJsonResult(FF_MAYBE_UNUSED FFLocalIpOptions* options, yyjs
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFLocalIpResult));
 
-    const char* error = ffDetectLocalIps(options, &results);
+    const char* error = detectLocalIp(options, &results);
 
     if(error)
     {
@@ -504,6 +527,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "List local IP addresses (v4 or v6), MAC addresses, etc",
     .parseCommandOptions = (void*) ffParseLocalIpCommandOptions,
     .parseJsonObject = (void*) ffParseLocalIpJsonObject,
+    .detectModule = (void*) ffDetectLocalIpModule,
     .printModule = (void*) ffPrintLocalIp,
     .generateJsonResult = (void*) ffGenerateLocalIpJsonResult,
     .generateJsonConfig = (void*) ffGenerateLocalIpJsonConfig,
@@ -41,6 +41,12 @@ static bool artistInSongTitle(const FFstrbuf* song, const FFstrbuf* artist)
     return false;
 }
 
+void ffDetectMediaModule(FF_MAYBE_UNUSED FFMediaOptions* options)
+{
+    // The result is memoized and shared with printing
+    ffDetectMedia();
+}
+
 void ffPrintMedia(FFMediaOptions* options)
 {
     const FFMediaResult* media = ffDetectMedia();
@@ -170,6 +176,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print playing song name",
     .parseCommandOptions = (void*) ffParseMediaCommandOptions,
     .parseJsonObject = (void*) ffParseMediaJsonObject,
+    .detectModule = (void*) ffDetectMediaModule,
     .printModule = (void*) ffPrintMedia,
     .generateJsonResult = (void*) ffGenerateMediaJsonResult,
     .generateJsonConfig = (void*) ffGenerateMediaJsonConfig,
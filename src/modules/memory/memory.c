@@ -6,10 +6,33 @@
 #include "modules/memory/memory.h"
 #include "util/stringUtils.h"
 
+static FFMemoryResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectMemory(FF_MAYBE_UNUSED FFMemoryOptions* options, FFMemoryResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    *result = (FFMemoryResult) {};
+    return ffDetectMemory(result);
+}
+
+void ffDetectMemoryModule(FFMemoryOptions* options)
+{
+    detectedError = detectMemory(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintMemory(FFMemoryOptions* options)
 {
-    FFMemoryResult storage = {};
-    const char* error = ffDetectMemory(&storage);
+    FFMemoryResult storage;
+    const char* error = detectMemory(options, &storage);
 
     if(error)
     {
@@ -117,7 +140,7 @@ void ffGenerateMemoryJsonConfig(FFMemoryOptions* options, yyjson_mut_doc* doc, y
 void ffGenerateMemoryJsonResult(FF_MAYBE_UNUSED FFMemoryOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FFMemoryResult storage;
-    const char* error = ffDetectMemory(&storage);
+    const char* error = detectMemory(options, &storage);
 
     if(error)
     {
@@ -135,6 +158,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print system memory usage info",
     .parseCommandOptions = (void*) ffParseMemoryCommandOptions,
     .parseJsonObject = (void*) ffParseMemoryJsonObject,
+    .detectModule = (void*) ffDetectMemoryModule,
     .printModule = (void*) ffPrintMemory,
     .generateJsonResult = (void*) ffGenerateMemoryJsonResult,
     .generateJsonConfig = (void*) ffGenerateMemoryJsonConfig,
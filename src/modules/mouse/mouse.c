@@ -21,11 +21,34 @@ static void printDevice(FFMouseOptions* options, const FFMouseDevice* device, ui
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectMouse(FF_MAYBE_UNUSED FFMouseOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectMouse(result);
+}
+
+void ffDetectMouseModule(FFMouseOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFMouseDevice));
+    detectedError = detectMouse(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintMouse(FFMouseOptions* options)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFMouseDevice));
 
-    const char* error = ffDetectMouse(&result);
+    const char* error = detectMouse(options, &result);
 
     if(error)
     {
@@ -87,7 +110,7 @@ void ffGenerateMouseJsonResult(FF_MAYBE_UNUSED FFMouseOptions* options, yyjson_m
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFMouseDevice));
 
-    const char* error = ffDetectMouse(&result);
+    const char* error = detectMouse(options, &result);
 
     if(error)
     {
@@ -115,6 +138,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "List connected mouses",
     .parseCommandOptions = (void*) ffParseMouseCommandOptions,
     .parseJsonObject = (void*) ffParseMouseJsonObject,
+    .detectModule = (void*) ffDetectMouseModule,
     .printModule = (void*) ffPrintMouse,
     .generateJsonResult = (void*) ffGenerateMouseJsonResult,
     .generateJsonConfig = (void*) ffGenerateMouseJsonConfig,
@@ -32,10 +32,33 @@ static void formatKey(const FFNetIOOptions* options, FFNetIOResult* inf, uint32_
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectNetIO(FFNetIOOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectNetIO(result, options);
+}
+
+void ffDetectNetIOModule(FFNetIOOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFNetIOResult));
+    detectedError = detectNetIO(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintNetIO(FFNetIOOptions* options)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFNetIOResult));
-    const char* error = ffDetectNetIO(&result, options);
+    const char* error = detectNetIO(options, &result);
 
     if(error)
     {
@@ -198,7 +221,7 @@ void ffGenerateNetIOJsonConfig(FFNetIOOptions* options, yyjson_mut_doc* doc, yyj
 void ffGenerateNetIOJsonResult(FFNetIOOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFNetIOResult));
-    const char* error = ffDetectNetIO(&result, options);
+    const char* error = detectNetIO(options, &result);
 
     if(error)
     {
@@ -233,6 +256,8 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print network I/O throughput",
     .parseCommandOptions = (void*) ffParseNetIOCommandOptions,
     .parseJsonObject = (void*) ffParseNetIOJsonObject,
+    .prepareModule = (void*) ffPrepareNetIO,
+    .detectModule = (void*) ffDetectNetIOModule,
     .printModule = (void*) ffPrintNetIO,
     .generateJsonResult = (void*) ffGenerateNetIOJsonResult,
     .generateJsonConfig = (void*) ffGenerateNetIOJsonConfig,
@@ -5,6 +5,12 @@
 #include "modules/opencl/opencl.h"
 #include "util/stringUtils.h"
 
+void ffDetectOpenCLModule(FF_MAYBE_UNUSED FFOpenCLOptions* options)
+{
+    // The result is memoized and shared with printing
+    ffDetectOpenCL();
+}
+
 void ffPrintOpenCL(FFOpenCLOptions* options)
 {
     FFOpenCLResult* result = ffDetectOpenCL();
@@ -133,6 +139,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print highest OpenCL version supported by the GPU",
     .parseCommandOptions = (void*) ffParseOpenCLCommandOptions,
     .parseJsonObject = (void*) ffParseOpenCLJsonObject,
+    .detectModule = (void*) ffDetectOpenCLModule,
     .printModule = (void*) ffPrintOpenCL,
     .generateJsonResult = (void*) ffGenerateOpenCLJsonResult,
     .generateJsonConfig = (void*) ffGenerateOpenCLJsonConfig,
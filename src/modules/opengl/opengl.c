@@ -4,16 +4,38 @@
 #include "modules/opengl/opengl.h"
 #include "util/stringUtils.h"
 
+static FFOpenGLResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectOpenGL(FFOpenGLOptions* options, FFOpenGLResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    ffStrbufInit(&result->version);
+    ffStrbufInit(&result->renderer);
+    ffStrbufInit(&result->vendor);
+    ffStrbufInit(&result->slv);
+    ffStrbufInit(&result->library);
+
+    return ffDetectOpenGL(options, result);
+}
+
+void ffDetectOpenGLModule(FFOpenGLOptions* options)
+{
+    detectedError = detectOpenGL(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintOpenGL(FFOpenGLOptions* options)
 {
     FFOpenGLResult result;
-    ffStrbufInit(&result.version);
-    ffStrbufInit(&result.renderer);
-    ffStrbufInit(&result.vendor);
-    ffStrbufInit(&result.slv);
-    ffStrbufInit(&result.library);
-
-    const char* error = ffDetectOpenGL(options, &result);
+    const char* error = detectOpenGL(options, &result);
     if(error)
     {
         ffPrintError(FF_OPENGL_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
@@ -124,13 +146,7 @@ void ffGenerateOpenGLJsonConfig(FFOpenGLOptions* options, yyjson_mut_doc* doc, y
 void ffGenerateOpenGLJsonResult(FF_MAYBE_UNUSED FFOpenGLOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FFOpenGLResult result;
-    ffStrbufInit(&result.version);
-    ffStrbufInit(&result.renderer);
-    ffStrbufInit(&result.vendor);
-    ffStrbufInit(&result.slv);
-    ffStrbufInit(&result.library);
-
-    const char* error = ffDetectOpenGL(options, &result);
+    const char* error = detectOpenGL(options, &result);
     if(error != NULL)
     {
         yyjson_mut_obj_add_str(doc, module, "error", error);
@@ -157,6 +173,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print highest OpenGL version supported by the GPU",
     .parseCommandOptions = (void*) ffParseOpenGLCommandOptions,
     .parseJsonObject = (void*) ffParseOpenGLJsonObject,
+    .detectModule = (void*) ffDetectOpenGLModule,
     .printModule = (void*) ffPrintOpenGL,
     .generateJsonResult = (void*) ffGenerateOpenGLJsonResult,
     .generateJsonConfig = (void*) ffGenerateOpenGLJsonConfig,
@@ -53,6 +53,12 @@ static void buildOutputDefault(const FFOSResult* os, FFstrbuf* result)
     }
 }
 
+void ffDetectOSModule(FF_MAYBE_UNUSED FFOSOptions* options)
+{
+    // The result is memoized and shared with printing
+    ffDetectOS();
+}
+
 void ffPrintOS(FFOSOptions* options)
 {
     const FFOSResult* os = ffDetectOS();
@@ -178,6 +184,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print operating system name and version",
     .parseCommandOptions = (void*) ffParseOSCommandOptions,
     .parseJsonObject = (void*) ffParseOSJsonObject,
+    .detectModule = (void*) ffDetectOSModule,
     .printModule = (void*) ffPrintOS,
     .generateJsonResult = (void*) ffGenerateOSJsonResult,
     .generateJsonConfig = (void*) ffGenerateOSJsonConfig,
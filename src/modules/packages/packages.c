@@ -4,12 +4,36 @@
 #include "modules/packages/packages.h"
 #include "util/stringUtils.h"
 
+static FFPackagesResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectPackages(FFPackagesOptions* options, FFPackagesResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    *result = (FFPackagesResult) {};
+    ffStrbufInit(&result->pacmanBranch);
+    return ffDetectPackages(result, options);
+}
+
+void ffDetectPackagesModule(FFPackagesOptions* options)
+{
+    detectedError = detectPackages(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintPackages(FFPackagesOptions* options)
 {
     FFPackagesResult counts = {};
     ffStrbufInit(&counts.pacmanBranch);
 
-    const char* error = ffDetectPackages(&counts, options);
+    const char* error = detectPackages(options, &counts);
 
     if(error)
     {
@@ -412,7 +436,7 @@ void ffGeneratePackagesJsonResult(FF_MAYBE_UNUSED FFPackagesOptions* options, yy
     FFPackagesResult counts = {};
     ffStrbufInit(&counts.pacmanBranch);
 
-    const char* error = ffDetectPackages(&counts, options);
+    const char* error = detectPackages(options, &counts);
 
     if(error)
     {
@@ -470,6 +494,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "List installed package managers and count of installed packages",
     .parseCommandOptions = (void*) ffParsePackagesCommandOptions,
     .parseJsonObject = (void*) ffParsePackagesJsonObject,
+    .detectModule = (void*) ffDetectPackagesModule,
     .printModule = (void*) ffPrintPackages,
     .generateJsonResult = (void*) ffGeneratePackagesJsonResult,
     .generateJsonConfig = (void*) ffGeneratePackagesJsonConfig,
@@ -31,10 +31,33 @@ static void formatKey(const FFPhysicalDiskOptions* options, FFPhysicalDiskResult
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectPhysicalDisk(FFPhysicalDiskOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectPhysicalDisk(result, options);
+}
+
+void ffDetectPhysicalDiskModule(FFPhysicalDiskOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFPhysicalDiskResult));
+    detectedError = detectPhysicalDisk(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintPhysicalDisk(FFPhysicalDiskOptions* options)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFPhysicalDiskResult));
-    const char* error = ffDetectPhysicalDisk(&result, options);
+    const char* error = detectPhysicalDisk(options, &result);
 
     if(error)
     {
@@ -194,7 +217,7 @@ void ffGeneratePhysicalDiskJsonConfig(FFPhysicalDiskOptions* options, yyjson_mut
 void ffGeneratePhysicalDiskJsonResult(FFPhysicalDiskOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFPhysicalDiskResult));
-    const char* error = ffDetectPhysicalDisk(&result, options);
+    const char* error = detectPhysicalDisk(options, &result);
 
     if(error)
     {
@@ -254,6 +277,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print physical disk information",
     .parseCommandOptions = (void*) ffParsePhysicalDiskCommandOptions,
     .parseJsonObject = (void*) ffParsePhysicalDiskJsonObject,
+    .detectModule = (void*) ffDetectPhysicalDiskModule,
     .printModule = (void*) ffPrintPhysicalDisk,
     .generateJsonResult = (void*) ffGeneratePhysicalDiskJsonResult,
     .generateJsonConfig = (void*) ffGeneratePhysicalDiskJsonConfig,
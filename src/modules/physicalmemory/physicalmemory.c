@@ -1,4 +1,5 @@
 #include "common/printing.h"
+#include "common/cache.h"
 #include "common/jsonconfig.h"
 #include "common/parsing.h"
 #include "common/percent.h"
@@ -8,10 +9,52 @@
 
 #define FF_PHYSICALMEMORY_DISPLAY_NAME "Physical Memory"
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const FFCacheField cacheFields[] = {
+    FF_CACHE_FIELD(FFPhysicalMemoryResult, size),
+    FF_CACHE_FIELD(FFPhysicalMemoryResult, maxSpeed),
+    FF_CACHE_FIELD(FFPhysicalMemoryResult, runningSpeed),
+    FF_CACHE_FIELD(FFPhysicalMemoryResult, type),
+    FF_CACHE_FIELD(FFPhysicalMemoryResult, formFactor),
+    FF_CACHE_FIELD(FFPhysicalMemoryResult, locator),
+    FF_CACHE_FIELD(FFPhysicalMemoryResult, partNumber),
+    FF_CACHE_FIELD(FFPhysicalMemoryResult, vendor),
+    FF_CACHE_FIELD(FFPhysicalMemoryResult, serial),
+    FF_CACHE_FIELD(FFPhysicalMemoryResult, ecc),
+};
+
+static const char* detectPhysicalMemory(FF_MAYBE_UNUSED FFPhysicalMemoryOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    if (ffCacheLoadResultList(FF_PHYSICALMEMORY_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result))
+        return NULL;
+
+    const char* error = ffDetectPhysicalMemory(result);
+    if (!error)
+        ffCacheSaveResultList(FF_PHYSICALMEMORY_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result);
+    return error;
+}
+
+void ffDetectPhysicalMemoryModule(FFPhysicalMemoryOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFPhysicalMemoryResult));
+    detectedError = detectPhysicalMemory(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintPhysicalMemory(FFPhysicalMemoryOptions* options)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFPhysicalMemoryResult));
-    const char* error = ffDetectPhysicalMemory(&result);
+    const char* error = detectPhysicalMemory(options, &result);
 
     if(error)
     {
@@ -118,7 +161,7 @@ void ffGeneratePhysicalMemoryJsonConfig(FFPhysicalMemoryOptions* options, yyjson
 void ffGeneratePhysicalMemoryJsonResult(FF_MAYBE_UNUSED FFPhysicalMemoryOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFPhysicalMemoryResult));
-    const char* error = ffDetectPhysicalMemory(&result);
+    const char* error = detectPhysicalMemory(options, &result);
 
     if(error)
     {
@@ -158,6 +201,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print system physical memory devices",
     .parseCommandOptions = (void*) ffParsePhysicalMemoryCommandOptions,
     .parseJsonObject = (void*) ffParsePhysicalMemoryJsonObject,
+    .detectModule = (void*) ffDetectPhysicalMemoryModule,
     .printModule = (void*) ffPrintPhysicalMemory,
     .generateJsonConfig = (void*) ffGeneratePhysicalMemoryJsonConfig,
     .generateJsonResult = (void*) ffGeneratePhysicalMemoryJsonResult,
@@ -8,6 +8,12 @@
 
 #define FF_PLAYER_DISPLAY_NAME "Media Player"
 
+void ffDetectPlayerModule(FF_MAYBE_UNUSED FFPlayerOptions* options)
+{
+    // The result is memoized and shared with printing
+    ffDetectMedia();
+}
+
 void ffPrintPlayer(FFPlayerOptions* options)
 {
     const FFMediaResult* media = ffDetectMedia();
@@ -126,6 +132,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print music player name",
     .parseCommandOptions = (void*) ffParsePlayerCommandOptions,
     .parseJsonObject = (void*) ffParsePlayerJsonObject,
+    .detectModule = (void*) ffDetectPlayerModule,
     .printModule = (void*) ffPrintPlayer,
     .generateJsonResult = (void*) ffGeneratePlayerJsonResult,
     .generateJsonConfig = (void*) ffGeneratePlayerJsonConfig,
@@ -6,11 +6,34 @@
 
 #define FF_POWERADAPTER_DISPLAY_NAME "Power Adapter"
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectPowerAdapter(FF_MAYBE_UNUSED FFPowerAdapterOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectPowerAdapter(result);
+}
+
+void ffDetectPowerAdapterModule(FFPowerAdapterOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFPowerAdapterResult));
+    detectedError = detectPowerAdapter(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintPowerAdapter(FFPowerAdapterOptions* options)
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFPowerAdapterResult));
 
-    const char* error = ffDetectPowerAdapter(&results);
+    const char* error = detectPowerAdapter(options, &results);
 
     if (error)
     {
@@ -95,7 +118,7 @@ void ffGeneratePowerAdapterJsonResult(FF_MAYBE_UNUSED FFPowerAdapterOptions* opt
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFPowerAdapterResult));
 
-    const char* error = ffDetectPowerAdapter(&results);
+    const char* error = detectPowerAdapter(options, &results);
 
     if (error)
     {
@@ -130,6 +153,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print power adapter name and charging watts",
     .parseCommandOptions = (void*) ffParsePowerAdapterCommandOptions,
     .parseJsonObject = (void*) ffParsePowerAdapterJsonObject,
+    .detectModule = (void*) ffDetectPowerAdapterModule,
     .printModule = (void*) ffPrintPowerAdapter,
     .generateJsonResult = (void*) ffGeneratePowerAdapterJsonResult,
     .generateJsonConfig = (void*) ffGeneratePowerAdapterJsonConfig,
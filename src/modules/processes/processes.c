@@ -4,10 +4,33 @@
 #include "modules/processes/processes.h"
 #include "util/stringUtils.h"
 
+static uint32_t detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectProcesses(FF_MAYBE_UNUSED FFProcessesOptions* options, uint32_t* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    *result = 0;
+    return ffDetectProcesses(result);
+}
+
+void ffDetectProcessesModule(FFProcessesOptions* options)
+{
+    detectedError = detectProcesses(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintProcesses(FFProcessesOptions* options)
 {
-    uint32_t numProcesses = 0;
-    const char* error = ffDetectProcesses(&numProcesses);
+    uint32_t numProcesses;
+    const char* error = detectProcesses(options, &numProcesses);
 
     if(error)
     {
@@ -67,7 +90,7 @@ void ffGenerateProcessesJsonConfig(FFProcessesOptions* options, yyjson_mut_doc*
 void ffGenerateProcessesJsonResult(FF_MAYBE_UNUSED FFProcessesOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     uint32_t result;
-    const char* error = ffDetectProcesses(&result);
+    const char* error = detectProcesses(options, &result);
 
     if(error)
     {
@@ -83,6 +106,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print number of running processes",
     .parseCommandOptions = (void*) ffParseProcessesCommandOptions,
     .parseJsonObject = (void*) ffParseProcessesJsonObject,
+    .detectModule = (void*) ffDetectProcessesModule,
     .printModule = (void*) ffPrintProcesses,
     .generateJsonResult = (void*) ffGenerateProcessesJsonResult,
     .generateJsonConfig = (void*) ffGenerateProcessesJsonConfig,
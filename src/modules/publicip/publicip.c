@@ -6,12 +6,34 @@
 
 #define FF_PUBLICIP_DISPLAY_NAME "Public IP"
 
+static FFPublicIpResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectPublicIp(FFPublicIpOptions* options, FFPublicIpResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    ffStrbufInit(&result->ip);
+    ffStrbufInit(&result->location);
+    return ffDetectPublicIp(options, result);
+}
+
+void ffDetectPublicIpModule(FFPublicIpOptions* options)
+{
+    detectedError = detectPublicIp(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintPublicIp(FFPublicIpOptions* options)
 {
     FFPublicIpResult result;
-    ffStrbufInit(&result.ip);
-    ffStrbufInit(&result.location);
-    const char* error = ffDetectPublicIp(options, &result);
+    const char* error = detectPublicIp(options, &result);
 
     if (error)
     {
@@ -58,6 +80,18 @@ bool ffParsePublicIpCommandOptions(FFPublicIpOptions* options, const char* key,
         return true;
     }
 
+    if (ffStrEqualsIgnCase(subKey, "cache-ttl"))
+    {
+        options->cacheTtl = ffOptionParseUInt32(key, value);
+        return true;
+    }
+
+    if (ffStrEqualsIgnCase(subKey, "cache-stale-while-revalidate"))
+    {
+        options->cacheStaleWhileRevalidate = ffOptionParseBoolean(value);
+        return true;
+    }
+
     if (ffStrEqualsIgnCase(subKey, "ipv6"))
     {
         options->ipv6 = ffOptionParseBoolean(value);
@@ -92,6 +126,18 @@ void ffParsePublicIpJsonObject(FFPublicIpOptions* options, yyjson_val* module)
             continue;
         }
 
+        if (ffStrEqualsIgnCase(key, "cacheTtl"))
+        {
+            options->cacheTtl = (uint32_t) yyjson_get_uint(val);
+            continue;
+        }
+
+        if (ffStrEqualsIgnCase(key, "cacheStaleWhileRevalidate"))
+        {
+            options->cacheStaleWhileRevalidate = yyjson_get_bool(val);
+            continue;
+        }
+
         if (ffStrEqualsIgnCase(key, "ipv6"))
         {
             options->ipv6 = yyjson_get_bool(val);
@@ -115,6 +161,12 @@ void ffGeneratePublicIpJsonConfig(FFPublicIpOptions* options, yyjson_mut_doc* do
     if (defaultOptions.timeout != options->timeout)
         yyjson_mut_obj_add_uint(doc, module, "timeout", options->timeout);
 
+    if (options->cacheTtl != defaultOptions.cacheTtl)
+        yyjson_mut_obj_add_uint(doc, module, "cacheTtl", options->cacheTtl);
+
+    if (options->cacheStaleWhileRevalidate != defaultOptions.cacheStaleWhileRevalidate)
+        yyjson_mut_obj_add_bool(doc, module, "cacheStaleWhileRevalidate", options->cacheStaleWhileRevalidate);
+
     if (defaultOptions.ipv6 != options->ipv6)
         yyjson_mut_obj_add_bool(doc, module, "ipv6", options->ipv6);
 }
@@ -122,9 +174,7 @@ void ffGeneratePublicIpJsonConfig(FFPublicIpOptions* options, yyjson_mut_doc* do
 void ffGeneratePublicIpJsonResult(FFPublicIpOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FFPublicIpResult result;
-    ffStrbufInit(&result.ip);
-    ffStrbufInit(&result.location);
-    const char* error = ffDetectPublicIp(options, &result);
+    const char* error = detectPublicIp(options, &result);
 
     if (error)
     {
@@ -145,6 +195,8 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print your public IP address, etc",
     .parseCommandOptions = (void*) ffParsePublicIpCommandOptions,
     .parseJsonObject = (void*) ffParsePublicIpJsonObject,
+    .prepareModule = (void*) ffPreparePublicIp,
+    .detectModule = (void*) ffDetectPublicIpModule,
     .printModule = (void*) ffPrintPublicIp,
     .generateJsonResult = (void*) ffGeneratePublicIpJsonResult,
     .generateJsonConfig = (void*) ffGeneratePublicIpJsonConfig,
@@ -161,6 +213,8 @@ void ffInitPublicIpOptions(FFPublicIpOptions* options)
 
     ffStrbufInit(&options->url);
     options->timeout = 0;
+    options->cacheTtl = 0;
+    options->cacheStaleWhileRevalidate = false;
     options->ipv6 = false;
 }
 
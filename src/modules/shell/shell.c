@@ -4,6 +4,12 @@
 #include "modules/shell/shell.h"
 #include "util/stringUtils.h"
 
+void ffDetectShellModule(FF_MAYBE_UNUSED FFShellOptions* options)
+{
+    // The result is memoized and shared with printing
+    ffDetectShell();
+}
+
 void ffPrintShell(FFShellOptions* options)
 {
     const FFShellResult* result = ffDetectShell();
@@ -107,6 +113,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print current shell name and version",
     .parseCommandOptions = (void*) ffParseShellCommandOptions,
     .parseJsonObject = (void*) ffParseShellJsonObject,
+    .detectModule = (void*) ffDetectShellModule,
     .printModule = (void*) ffPrintShell,
     .generateJsonResult = (void*) ffGenerateShellJsonResult,
     .generateJsonConfig = (void*) ffGenerateShellJsonConfig,
@@ -63,11 +63,34 @@ static void printDevice(FFSoundOptions* options, const FFSoundDevice* device, ui
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectSound(FF_MAYBE_UNUSED FFSoundOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectSound(result);
+}
+
+void ffDetectSoundModule(FFSoundOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFSoundDevice));
+    detectedError = detectSound(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintSound(FFSoundOptions* options)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFSoundDevice));
 
-    const char* error = ffDetectSound(&result);
+    const char* error = detectSound(options, &result);
 
     if(error)
     {
@@ -198,7 +221,7 @@ void ffGenerateSoundJsonConfig(FFSoundOptions* options, yyjson_mut_doc* doc, yyj
 void ffGenerateSoundJsonResult(FF_MAYBE_UNUSED FFSoundOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFSoundDevice));
-    const char* error = ffDetectSound(&result);
+    const char* error = detectSound(options, &result);
 
     if(error)
     {
@@ -236,6 +259,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print sound devices, volume, etc",
     .parseCommandOptions = (void*) ffParseSoundCommandOptions,
     .parseJsonObject = (void*) ffParseSoundJsonObject,
+    .detectModule = (void*) ffDetectSoundModule,
     .printModule = (void*) ffPrintSound,
     .generateJsonResult = (void*) ffGenerateSoundJsonResult,
     .generateJsonConfig = (void*) ffGenerateSoundJsonConfig,
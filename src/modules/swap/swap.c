@@ -6,10 +6,33 @@
 #include "modules/swap/swap.h"
 #include "util/stringUtils.h"
 
+static FFSwapResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectSwap(FF_MAYBE_UNUSED FFSwapOptions* options, FFSwapResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    *result = (FFSwapResult) {};
+    return ffDetectSwap(result);
+}
+
+void ffDetectSwapModule(FFSwapOptions* options)
+{
+    detectedError = detectSwap(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintSwap(FFSwapOptions* options)
 {
-    FFSwapResult storage = {};
-    const char* error = ffDetectSwap(&storage);
+    FFSwapResult storage;
+    const char* error = detectSwap(options, &storage);
 
     if(error)
     {
@@ -126,7 +149,7 @@ void ffGenerateSwapJsonConfig(FFSwapOptions* options, yyjson_mut_doc* doc, yyjso
 void ffGenerateSwapJsonResult(FF_MAYBE_UNUSED FFSwapOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FFSwapResult storage;
-    const char* error = ffDetectSwap(&storage);
+    const char* error = detectSwap(options, &storage);
 
     if(error)
     {
@@ -144,6 +167,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print swap (paging file) space usage",
     .parseCommandOptions = (void*) ffParseSwapCommandOptions,
     .parseJsonObject = (void*) ffParseSwapJsonObject,
+    .detectModule = (void*) ffDetectSwapModule,
     .printModule = (void*) ffPrintSwap,
     .generateJsonResult = (void*) ffGenerateSwapJsonResult,
     .generateJsonConfig = (void*) ffGenerateSwapJsonConfig,
@@ -4,6 +4,12 @@
 #include "modules/terminal/terminal.h"
 #include "util/stringUtils.h"
 
+void ffDetectTerminalModule(FF_MAYBE_UNUSED FFTerminalOptions* options)
+{
+    // The result is memoized and shared with printing
+    ffDetectTerminal();
+}
+
 void ffPrintTerminal(FFTerminalOptions* options)
 {
     const FFTerminalResult* result = ffDetectTerminal();
@@ -100,6 +106,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print current terminal name and version",
     .parseCommandOptions = (void*) ffParseTerminalCommandOptions,
     .parseJsonObject = (void*) ffParseTerminalJsonObject,
+    .detectModule = (void*) ffDetectTerminalModule,
     .printModule = (void*) ffPrintTerminal,
     .generateJsonResult = (void*) ffGenerateTerminalJsonResult,
     .generateJsonConfig = (void*) ffGenerateTerminalJsonConfig,
@@ -4,13 +4,39 @@
 #include "modules/theme/theme.h"
 #include "util/stringUtils.h"
 
+static FFThemeResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectTheme(FF_MAYBE_UNUSED FFThemeOptions* options, FFThemeResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    *result = (FFThemeResult) {
+        .theme1 = ffStrbufCreate(),
+        .theme2 = ffStrbufCreate(),
+    };
+    return ffDetectTheme(result);
+}
+
+void ffDetectThemeModule(FFThemeOptions* options)
+{
+    detectedError = detectTheme(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintTheme(FFThemeOptions* options)
 {
     FFThemeResult result = {
         .theme1 = ffStrbufCreate(),
         .theme2 = ffStrbufCreate()
     };
-    const char* error = ffDetectTheme(&result);
+    const char* error = detectTheme(options, &result);
 
     if(error)
     {
@@ -84,7 +110,7 @@ void ffGenerateThemeJsonResult(FF_MAYBE_UNUSED FFThemeOptions* options, yyjson_m
         .theme1 = ffStrbufCreate(),
         .theme2 = ffStrbufCreate()
     };
-    const char* error = ffDetectTheme(&result);
+    const char* error = detectTheme(options, &result);
 
     if(error)
     {
@@ -105,6 +131,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print current theme of desktop environment",
     .parseCommandOptions = (void*) ffParseThemeCommandOptions,
     .parseJsonObject = (void*) ffParseThemeJsonObject,
+    .detectModule = (void*) ffDetectThemeModule,
     .printModule = (void*) ffPrintTheme,
     .generateJsonResult = (void*) ffGenerateThemeJsonResult,
     .generateJsonConfig = (void*) ffGenerateThemeJsonConfig,
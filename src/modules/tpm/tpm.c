@@ -1,16 +1,52 @@
 #include "common/printing.h"
+#include "common/cache.h"
 #include "common/jsonconfig.h"
 #include "detection/tpm/tpm.h"
 #include "modules/tpm/tpm.h"
 #include "util/stringUtils.h"
 
-void ffPrintTPM(FFTPMOptions* options)
+static FFTPMResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const FFCacheField cacheFields[] = {
+    FF_CACHE_FIELD(FFTPMResult, version),
+    FF_CACHE_FIELD(FFTPMResult, description),
+};
+
+static const char* detectTPM(FF_MAYBE_UNUSED FFTPMOptions* options, FFTPMResult* result)
 {
-    FFTPMResult result = {
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    *result = (FFTPMResult) {
         .version = ffStrbufCreate(),
         .description = ffStrbufCreate()
     };
-    const char* error = ffDetectTPM(&result);
+
+    if (ffCacheLoadResult(FF_TPM_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result))
+        return NULL;
+
+    const char* error = ffDetectTPM(result);
+    if (!error)
+        ffCacheSaveResult(FF_TPM_MODULE_NAME, NULL, 0, cacheFields, ARRAY_SIZE(cacheFields), result);
+    return error;
+}
+
+void ffDetectTPMModule(FFTPMOptions* options)
+{
+    detectedError = detectTPM(options, &detectedResult);
+    detected = true;
+}
+
+void ffPrintTPM(FFTPMOptions* options)
+{
+    FFTPMResult result;
+    const char* error = detectTPM(options, &result);
 
     if(error)
     {
@@ -73,13 +109,10 @@ void ffGenerateTPMJsonConfig(FFTPMOptions* options, yyjson_mut_doc* doc, yyjson_
     ffJsonConfigGenerateModuleArgsConfig(doc, module, &defaultOptions.moduleArgs, &options->moduleArgs);
 }
 
-void ffGenerateTPMJsonResult(FF_MAYBE_UNUSED FFTerminalOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
+void ffGenerateTPMJsonResult(FF_MAYBE_UNUSED FFTPMOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
-    FFTPMResult result = {
-        .version = ffStrbufCreate(),
-        .description = ffStrbufCreate()
-    };
-    const char* error = ffDetectTPM(&result);
+    FFTPMResult result;
+    const char* error = detectTPM(options, &result);
 
     if(error)
     {
@@ -100,6 +133,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print info of Trusted Platform Module (TPM) Security Device",
     .parseCommandOptions = (void*) ffParseTPMCommandOptions,
     .parseJsonObject = (void*) ffParseTPMJsonObject,
+    .detectModule = (void*) ffDetectTPMModule,
     .printModule = (void*) ffPrintTPM,
     .generateJsonResult = (void*) ffGenerateTPMJsonResult,
     .generateJsonConfig = (void*) ffGenerateTPMJsonConfig,
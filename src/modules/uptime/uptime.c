@@ -5,11 +5,32 @@
 #include "modules/uptime/uptime.h"
 #include "util/stringUtils.h"
 
+static FFUptimeResult detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectUptime(FF_MAYBE_UNUSED FFUptimeOptions* options, FFUptimeResult* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectUptime(result);
+}
+
+void ffDetectUptimeModule(FFUptimeOptions* options)
+{
+    detectedError = detectUptime(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintUptime(FFUptimeOptions* options)
 {
     FFUptimeResult result;
-
-    const char* error = ffDetectUptime(&result);
+    const char* error = detectUptime(options, &result);
 
     if(error)
     {
@@ -88,7 +109,7 @@ void ffGenerateUptimeJsonConfig(FFUptimeOptions* options, yyjson_mut_doc* doc, y
 void ffGenerateUptimeJsonResult(FF_MAYBE_UNUSED FFUptimeOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FFUptimeResult result;
-    const char* error = ffDetectUptime(&result);
+    const char* error = detectUptime(options, &result);
 
     if(error)
     {
@@ -106,6 +127,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print how long system has been running",
     .parseCommandOptions = (void*) ffParseUptimeCommandOptions,
     .parseJsonObject = (void*) ffParseUptimeJsonObject,
+    .detectModule = (void*) ffDetectUptimeModule,
     .printModule = (void*) ffPrintUptime,
     .generateJsonResult = (void*) ffGenerateUptimeJsonResult,
     .generateJsonConfig = (void*) ffGenerateUptimeJsonConfig,
@@ -7,11 +7,34 @@
 
 #pragma GCC diagnostic ignored "-Wformat" // warning: unknown conversion type character 'F' in format
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectUsers(FFUsersOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectUsers(options, result);
+}
+
+void ffDetectUsersModule(FFUsersOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFUserResult));
+    detectedError = detectUsers(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintUsers(FFUsersOptions* options)
 {
     FF_LIST_AUTO_DESTROY users = ffListCreate(sizeof(FFUserResult));
 
-    const char* error = ffDetectUsers(options, &users);
+    const char* error = detectUsers(options, &users);
 
     if(error)
     {
@@ -171,7 +194,7 @@ void ffGenerateUsersJsonResult(FFUsersOptions* options, yyjson_mut_doc* doc, yyj
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFUserResult));
 
-    const char* error = ffDetectUsers(options, &results);
+    const char* error = detectUsers(options, &results);
 
     if(error)
     {
@@ -208,6 +231,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print users currently logged in",
     .parseCommandOptions = (void*) ffParseUsersCommandOptions,
     .parseJsonObject = (void*) ffParseUsersJsonObject,
+    .detectModule = (void*) ffDetectUsersModule,
     .printModule = (void*) ffPrintUsers,
     .generateJsonResult = (void*) ffGenerateUsersJsonResult,
     .generateJsonConfig = (void*) ffGenerateUsersJsonConfig,
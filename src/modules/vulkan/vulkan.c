@@ -5,6 +5,12 @@
 #include "modules/vulkan/vulkan.h"
 #include "util/stringUtils.h"
 
+void ffDetectVulkanModule(FF_MAYBE_UNUSED FFVulkanOptions* options)
+{
+    // The result is memoized and shared with printing
+    ffDetectVulkan();
+}
+
 void ffPrintVulkan(FFVulkanOptions* options)
 {
     const FFVulkanResult* vulkan = ffDetectVulkan();
@@ -147,6 +153,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print highest Vulkan version supported by the GPU",
     .parseCommandOptions = (void*) ffParseVulkanCommandOptions,
     .parseJsonObject = (void*) ffParseVulkanJsonObject,
+    .detectModule = (void*) ffDetectVulkanModule,
     .printModule = (void*) ffPrintVulkan,
     .generateJsonResult = (void*) ffGenerateVulkanJsonResult,
     .generateJsonConfig = (void*) ffGenerateVulkanJsonConfig,
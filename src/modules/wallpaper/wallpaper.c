@@ -4,10 +4,33 @@
 #include "modules/wallpaper/wallpaper.h"
 #include "util/stringUtils.h"
 
+static FFstrbuf detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectWallpaper(FF_MAYBE_UNUSED FFWallpaperOptions* options, FFstrbuf* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    ffStrbufInit(result);
+    return ffDetectWallpaper(result);
+}
+
+void ffDetectWallpaperModule(FFWallpaperOptions* options)
+{
+    detectedError = detectWallpaper(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintWallpaper(FFWallpaperOptions* options)
 {
     FF_STRBUF_AUTO_DESTROY fullpath = ffStrbufCreate();
-    const char* error = ffDetectWallpaper(&fullpath);
+    const char* error = detectWallpaper(options, &fullpath);
 
     const uint32_t index = ffStrbufLastIndexC(&fullpath,
         #ifndef _WIN32
@@ -78,7 +101,7 @@ void ffGenerateWallpaperJsonConfig(FFWallpaperOptions* options, yyjson_mut_doc*
 void ffGenerateWallpaperJsonResult(FF_MAYBE_UNUSED FFWallpaperOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_STRBUF_AUTO_DESTROY fullpath = ffStrbufCreate();
-    const char* error = ffDetectWallpaper(&fullpath);
+    const char* error = detectWallpaper(options, &fullpath);
     if(error)
     {
         yyjson_mut_obj_add_str(doc, module, "error", error);
@@ -92,6 +115,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print image file path of current wallpaper",
     .parseCommandOptions = (void*) ffParseWallpaperCommandOptions,
     .parseJsonObject = (void*) ffParseWallpaperJsonObject,
+    .detectModule = (void*) ffDetectWallpaperModule,
     .printModule = (void*) ffPrintWallpaper,
     .generateJsonResult = (void*) ffGenerateWallpaperJsonResult,
     .generateJsonConfig = (void*) ffGenerateWallpaperJsonConfig,
@@ -4,10 +4,33 @@
 #include "modules/weather/weather.h"
 #include "util/stringUtils.h"
 
+static FFstrbuf detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectWeather(FFWeatherOptions* options, FFstrbuf* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectWeather(options, result);
+}
+
+void ffDetectWeatherModule(FFWeatherOptions* options)
+{
+    ffStrbufInit(&detectedResult);
+    detectedError = detectWeather(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintWeather(FFWeatherOptions* options)
 {
     FF_STRBUF_AUTO_DESTROY result = ffStrbufCreate();
-    const char* error = ffDetectWeather(options, &result);
+    const char* error = detectWeather(options, &result);
 
     if(error)
     {
@@ -54,6 +77,18 @@ bool ffParseWeatherCommandOptions(FFWeatherOptions* options, const char* key, co
         return true;
     }
 
+    if (ffStrEqualsIgnCase(subKey, "cache-ttl"))
+    {
+        options->cacheTtl = ffOptionParseUInt32(key, value);
+        return true;
+    }
+
+    if (ffStrEqualsIgnCase(subKey, "cache-stale-while-revalidate"))
+    {
+        options->cacheStaleWhileRevalidate = ffOptionParseBoolean(value);
+        return true;
+    }
+
     return false;
 }
 
@@ -88,6 +123,18 @@ void ffParseWeatherJsonObject(FFWeatherOptions* options, yyjson_val* module)
             continue;
         }
 
+        if (ffStrEqualsIgnCase(key, "cacheTtl"))
+        {
+            options->cacheTtl = (uint32_t) yyjson_get_uint(val);
+            continue;
+        }
+
+        if (ffStrEqualsIgnCase(key, "cacheStaleWhileRevalidate"))
+        {
+            options->cacheStaleWhileRevalidate = yyjson_get_bool(val);
+            continue;
+        }
+
         ffPrintError(FF_WEATHER_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "Unknown JSON key %s", key);
     }
 }
@@ -107,12 +154,18 @@ void ffGenerateWeatherJsonConfig(FFWeatherOptions* options, yyjson_mut_doc* doc,
 
     if (options->timeout != defaultOptions.timeout)
         yyjson_mut_obj_add_uint(doc, module, "timeout", options->timeout);
+
+    if (options->cacheTtl != defaultOptions.cacheTtl)
+        yyjson_mut_obj_add_uint(doc, module, "cacheTtl", options->cacheTtl);
+
+    if (options->cacheStaleWhileRevalidate != defaultOptions.cacheStaleWhileRevalidate)
+        yyjson_mut_obj_add_bool(doc, module, "cacheStaleWhileRevalidate", options->cacheStaleWhileRevalidate);
 }
 
 void ffGenerateWeatherJsonResult(FFWeatherOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_STRBUF_AUTO_DESTROY result = ffStrbufCreate();
-    const char* error = ffDetectWeather(options, &result);
+    const char* error = detectWeather(options, &result);
 
     if (error)
     {
@@ -128,6 +181,8 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print weather information",
     .parseCommandOptions = (void*) ffParseWeatherCommandOptions,
     .parseJsonObject = (void*) ffParseWeatherJsonObject,
+    .prepareModule = (void*) ffPrepareWeather,
+    .detectModule = (void*) ffDetectWeatherModule,
     .printModule = (void*) ffPrintWeather,
     .generateJsonResult = (void*) ffGenerateWeatherJsonResult,
     .generateJsonConfig = (void*) ffGenerateWeatherJsonConfig,
@@ -144,6 +199,8 @@ void ffInitWeatherOptions(FFWeatherOptions* options)
     ffStrbufInit(&options->location);
     ffStrbufInitStatic(&options->outputFormat, "%t+-+%C+(%l)");
     options->timeout = 0;
+    options->cacheTtl = 0;
+    options->cacheStaleWhileRevalidate = false;
 }
 
 void ffDestroyWeatherOptions(FFWeatherOptions* options)
@@ -4,11 +4,34 @@
 #include "modules/wifi/wifi.h"
 #include "util/stringUtils.h"
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectWifi(FF_MAYBE_UNUSED FFWifiOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectWifi(result);
+}
+
+void ffDetectWifiModule(FFWifiOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFWifiResult));
+    detectedError = detectWifi(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintWifi(FFWifiOptions* options)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFWifiResult));
 
-    const char* error = ffDetectWifi(&result);
+    const char* error = detectWifi(options, &result);
     if(error)
     {
         ffPrintError(FF_WIFI_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
@@ -179,7 +202,7 @@ void ffGenerateWifiJsonConfig(FFWifiOptions* options, yyjson_mut_doc* doc, yyjso
 void ffGenerateWifiJsonResult(FF_MAYBE_UNUSED FFWifiOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module)
 {
     FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFWifiResult));
-    const char* error = ffDetectWifi(&result);
+    const char* error = detectWifi(options, &result);
     if(error)
     {
         yyjson_mut_obj_add_str(doc, module, "error", error);
@@ -225,6 +248,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print connected Wi-Fi info (SSID, connection and security protocol)",
     .parseCommandOptions = (void*) ffParseWifiCommandOptions,
     .parseJsonObject = (void*) ffParseWifiJsonObject,
+    .detectModule = (void*) ffDetectWifiModule,
     .printModule = (void*) ffPrintWifi,
     .generateJsonResult = (void*) ffGenerateWifiJsonResult,
     .generateJsonConfig = (void*) ffGenerateWifiJsonConfig,
@@ -5,6 +5,12 @@
 #include "modules/wm/wm.h"
 #include "util/stringUtils.h"
 
+void ffDetectWMModule(FF_MAYBE_UNUSED FFWMOptions* options)
+{
+    // The result is memoized and shared with printing
+    ffConnectDisplayServer();
+}
+
 void ffPrintWM(FFWMOptions* options)
 {
     const FFDisplayServerResult* result = ffConnectDisplayServer();
@@ -144,6 +150,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print window manager name and version",
     .parseCommandOptions = (void*) ffParseWMCommandOptions,
     .parseJsonObject = (void*) ffParseWMJsonObject,
+    .detectModule = (void*) ffDetectWMModule,
     .printModule = (void*) ffPrintWM,
     .generateJsonResult = (void*) ffGenerateWMJsonResult,
     .generateJsonConfig = (void*) ffGenerateWMJsonConfig,
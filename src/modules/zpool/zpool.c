@@ -75,11 +75,34 @@ static void printZpool(FFZpoolOptions* options, FFZpoolResult* result, uint8_t i
     }
 }
 
+static FFlist detectedResult;
+static const char* detectedError;
+static bool detected;
+
+static const char* detectZpool(FF_MAYBE_UNUSED FFZpoolOptions* options, FFlist* result)
+{
+    if (detected)
+    {
+        detected = false;
+        *result = detectedResult;
+        return detectedError;
+    }
+
+    return ffDetectZpool(result);
+}
+
+void ffDetectZpoolModule(FFZpoolOptions* options)
+{
+    detectedResult = ffListCreate(sizeof(FFZpoolResult));
+    detectedError = detectZpool(options, &detectedResult);
+    detected = true;
+}
+
 void ffPrintZpool(FFZpoolOptions* options)
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFZpoolResult));
 
-    const char* error = ffDetectZpool(&results);
+    const char* error = detectZpool(options, &results);
 
     if (error)
     {
@@ -153,7 +176,7 @@ void ffGenerateZpoolJsonResult(FF_MAYBE_UNUSED FFZpoolOptions* options, yyjson_m
 {
     FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFZpoolResult));
 
-    const char* error = ffDetectZpool(&results);
+    const char* error = detectZpool(options, &results);
     if (error)
     {
         yyjson_mut_obj_add_str(doc, module, "error", error);
@@ -185,6 +208,7 @@ static FFModuleBaseInfo ffModuleInfo = {
     .description = "Print ZFS storage pools",
     .parseCommandOptions = (void*) ffParseZpoolCommandOptions,
     .parseJsonObject = (void*) ffParseZpoolJsonObject,
+    .detectModule = (void*) ffDetectZpoolModule,
     .printModule = (void*) ffPrintZpool,
     .generateJsonResult = (void*) ffGenerateZpoolJsonResult,
     .generateJsonConfig = (void*) ffGenerateZpoolJsonConfig,
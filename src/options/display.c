@@ -47,6 +47,8 @@ const char* ffOptionsParseDisplayJsonConfig(FFOptionsDisplay* options, yyjson_va
             options->disableLinewrap = yyjson_get_bool(val);
         else if (ffStrEqualsIgnCase(key, "hideCursor"))
             options->hideCursor = yyjson_get_bool(val);
+        else if (ffStrEqualsIgnCase(key, "progressive"))
+            options->progressive = yyjson_get_bool(val);
         else if (ffStrEqualsIgnCase(key, "separator"))
             ffStrbufSetS(&options->keyValueSeparator, yyjson_get_str(val));
         else if (ffStrEqualsIgnCase(key, "color"))
@@ -325,6 +327,8 @@ bool ffOptionsParseDisplayCommandLine(FFOptionsDisplay* options, const char* key
         options->disableLinewrap = ffOptionParseBoolean(value);
     else if(ffStrEqualsIgnCase(key, "--hide-cursor"))
         options->hideCursor = ffOptionParseBoolean(value);
+    else if(ffStrEqualsIgnCase(key, "--progressive"))
+        options->progressive = ffOptionParseBoolean(value);
     else if(ffStrEqualsIgnCase(key, "--separator"))
         ffOptionParseString(key, value, &options->keyValueSeparator);
     else if(ffStrEqualsIgnCase(key, "--color"))
@@ -513,6 +517,7 @@ void ffOptionsInitDisplay(FFOptionsDisplay* options)
     #endif
 
     options->hideCursor = false;
+    options->progressive = false;
     options->sizeBinaryPrefix = FF_SIZE_BINARY_PREFIX_TYPE_IEC;
     options->sizeNdigits = 2;
     options->sizeMaxPrefix = UINT8_MAX;
@@ -584,6 +589,9 @@ void ffOptionsGenerateDisplayJsonConfig(FFOptionsDisplay* options, yyjson_mut_do
     if (options->hideCursor != defaultOptions.hideCursor)
         yyjson_mut_obj_add_bool(doc, obj, "hideCursor", options->hideCursor);
 
+    if (options->progressive != defaultOptions.progressive)
+        yyjson_mut_obj_add_bool(doc, obj, "progressive", options->progressive);
+
     if (!ffStrbufEqual(&options->keyValueSeparator, &defaultOptions.keyValueSeparator))
         yyjson_mut_obj_add_strbuf(doc, obj, "separator", &options->keyValueSeparator);
 
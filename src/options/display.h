@@ -37,6 +37,7 @@ typedef struct FFOptionsDisplay
     #endif
     bool disableLinewrap;
     bool hideCursor;
+    bool progressive;
     FFSizeBinaryPrefixType sizeBinaryPrefix;
     uint8_t sizeNdigits;
     uint8_t sizeMaxPrefix;
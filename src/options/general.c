@@ -29,6 +29,14 @@ const char* ffOptionsParseGeneralJsonConfig(FFOptionsGeneral* options, yyjson_va
         }
         else if (ffStrEqualsIgnCase(key, "detectVersion"))
             options->detectVersion = yyjson_get_bool(val);
+        else if (ffStrEqualsIgnCase(key, "hardwareCache"))
+            options->hardwareCache = yyjson_get_bool(val);
+        else if (ffStrEqualsIgnCase(key, "versionCache"))
+            options->versionCache = yyjson_get_bool(val);
+        else if (ffStrEqualsIgnCase(key, "deadline"))
+            options->deadline = (uint32_t) yyjson_get_uint(val);
+        else if (ffStrEqualsIgnCase(key, "deadlinePlaceholder"))
+            ffStrbufSetS(&options->deadlinePlaceholder, yyjson_get_str(val));
 
         #if defined(__linux__) || defined(__FreeBSD__) || defined(__sun) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__HAIKU__)
         else if (ffStrEqualsIgnCase(key, "playerName"))
@@ -72,6 +80,14 @@ bool ffOptionsParseGeneralCommandLine(FFOptionsGeneral* options, const char* key
         options->processingTimeout = ffOptionParseInt32(key, value);
     else if(ffStrEqualsIgnCase(key, "--detect-version"))
         options->detectVersion = ffOptionParseBoolean(value);
+    else if(ffStrEqualsIgnCase(key, "--hardware-cache"))
+        options->hardwareCache = ffOptionParseBoolean(value);
+    else if(ffStrEqualsIgnCase(key, "--version-cache"))
+        options->versionCache = ffOptionParseBoolean(value);
+    else if(ffStrEqualsIgnCase(key, "--deadline"))
+        options->deadline = ffOptionParseUInt32(key, value);
+    else if(ffStrEqualsIgnCase(key, "--deadline-placeholder"))
+        ffOptionParseString(key, value, &options->deadlinePlaceholder);
 
     #if defined(__linux__) || defined(__FreeBSD__) || defined(__sun) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__HAIKU__)
     else if(ffStrEqualsIgnCase(key, "--player-name"))
@@ -101,6 +117,10 @@ void ffOptionsInitGeneral(FFOptionsGeneral* options)
     options->processingTimeout = 5000;
     options->multithreading = true;
     options->detectVersion = true;
+    options->hardwareCache = false;
+    options->versionCache = true;
+    options->deadline = 0;
+    ffStrbufInit(&options->deadlinePlaceholder);
 
     #if defined(__linux__) || defined(__FreeBSD__) || defined(__sun) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__HAIKU__)
     ffStrbufInit(&options->playerName);
@@ -110,8 +130,10 @@ void ffOptionsInitGeneral(FFOptionsGeneral* options)
     #endif
 }
 
-void ffOptionsDestroyGeneral(FF_MAYBE_UNUSED FFOptionsGeneral* options)
+void ffOptionsDestroyGeneral(FFOptionsGeneral* options)
 {
+    ffStrbufDestroy(&options->deadlinePlaceholder);
+
     #if defined(__linux__) || defined(__FreeBSD__) || defined(__sun) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__HAIKU__)
     ffStrbufDestroy(&options->playerName);
     #endif
@@ -130,6 +152,18 @@ void ffOptionsGenerateGeneralJsonConfig(FFOptionsGeneral* options, yyjson_mut_do
     if (options->processingTimeout != defaultOptions.processingTimeout)
         yyjson_mut_obj_add_int(doc, obj, "processingTimeout", options->processingTimeout);
 
+    if (options->hardwareCache != defaultOptions.hardwareCache)
+        yyjson_mut_obj_add_bool(doc, obj, "hardwareCache", options->hardwareCache);
+
+    if (options->versionCache != defaultOptions.versionCache)
+        yyjson_mut_obj_add_bool(doc, obj, "versionCache", options->versionCache);
+
+    if (options->deadline != defaultOptions.deadline)
+        yyjson_mut_obj_add_uint(doc, obj, "deadline", options->deadline);
+
+    if (!ffStrbufEqual(&options->deadlinePlaceholder, &defaultOptions.deadlinePlaceholder))
+        yyjson_mut_obj_add_strbuf(doc, obj, "deadlinePlaceholder", &options->deadlinePlaceholder);
+
     #if defined(__linux__) || defined(__FreeBSD__) || defined(__sun) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__HAIKU__)
 
     if (!ffStrbufEqual(&options->playerName, &defaultOptions.playerName))
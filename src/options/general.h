@@ -14,6 +14,10 @@ typedef struct FFOptionsGeneral
     bool multithreading;
     int32_t processingTimeout;
     bool detectVersion;
+    bool hardwareCache;
+    bool versionCache;
+    uint32_t deadline;
+    FFstrbuf deadlinePlaceholder;
 
     // Module options that cannot be put in module option structure
     #if defined(__linux__) || defined(__FreeBSD__) || defined(__sun) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__HAIKU__)
@@ -1,5 +1,6 @@
 #include "fastfetch.h"
 #include "smc_temps.h"
+#include "common/thread.h"
 #include "util/stringUtils.h"
 
 #include <stdint.h>
@@ -283,12 +284,11 @@ static bool detectTemp(io_connect_t conn, const char* sensor, double* sum)
 const char* ffDetectSmcTemps(enum FFTempType type, double* result)
 {
     static io_connect_t conn;
-    if (!conn)
-    {
-        if (smcOpen(&conn) != NULL)
-            conn = (io_connect_t) -1;
-    }
-    else if (conn == (io_connect_t) -1)
+    static const char* connError;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+    FF_ONCE(&once)
+        connError = smcOpen(&conn);
+    if (connError)
         return "Could not open SMC connection";
 
     uint32_t count = 0;
@@ -2,11 +2,13 @@
 
 #if __linux__
 #include "common/io/io.h"
+#include "common/thread.h"
 
 bool ffKmodLoaded(const char* modName)
 {
     static FFstrbuf modules;
-    if (modules.chars == NULL)
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+    FF_ONCE(&once)
     {
         ffStrbufInitS(&modules, "\n");
         ffAppendFileBuffer("/proc/modules", &modules);
@@ -1,5 +1,6 @@
 #include "smbiosHelper.h"
 #include "common/io/io.h"
+#include "common/thread.h"
 #include "util/unused.h"
 #include "util/mallocHelper.h"
 #include "util/debug.h"
@@ -132,7 +133,7 @@ typedef union FFSmbiosEntryPoint
     FFSmbios30EntryPoint Smbios30;
 } FFSmbiosEntryPoint;
 
-const FFSmbiosHeaderTable* ffGetSmbiosHeaderTable()
+static const FFSmbiosHeaderTable* loadSmbiosHeaderTable()
 {
     static FFstrbuf buffer;
     static FFSmbiosHeaderTable table;
@@ -431,6 +432,17 @@ const FFSmbiosHeaderTable* ffGetSmbiosHeaderTable()
 
     return &table;
 }
+
+const FFSmbiosHeaderTable* ffGetSmbiosHeaderTable()
+{
+    static const FFSmbiosHeaderTable* result;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+
+    FF_ONCE(&once)
+        result = loadSmbiosHeaderTable();
+
+    return result;
+}
 #elif defined(_WIN32)
 #include <windows.h>
 
@@ -446,7 +458,7 @@ typedef struct FFRawSmbiosData
     uint8_t SMBIOSTableData[];
 } FFRawSmbiosData;
 
-const FFSmbiosHeaderTable* ffGetSmbiosHeaderTable()
+static const FFSmbiosHeaderTable* loadSmbiosHeaderTable()
 {
     static FFRawSmbiosData* buffer;
     static FFSmbiosHeaderTable table;
@@ -500,4 +512,15 @@ const FFSmbiosHeaderTable* ffGetSmbiosHeaderTable()
 
     return &table;
 }
+
+const FFSmbiosHeaderTable* ffGetSmbiosHeaderTable()
+{
+    static const FFSmbiosHeaderTable* result;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+
+    FF_ONCE(&once)
+        result = loadSmbiosHeaderTable();
+
+    return result;
+}
 #endif
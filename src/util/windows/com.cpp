@@ -1,5 +1,6 @@
 #include "com.hpp"
 #include "fastfetch.h"
+#include "common/thread.h"
 
 #include <stdlib.h>
 
@@ -39,8 +40,9 @@ static const char* doInitCom()
 
 const char* ffInitCom(void)
 {
-    static const char* error = "";
-    if (error && error[0] == '\0')
+    static const char* error;
+    static FFThreadOnce once = FF_THREAD_ONCE_INITIALIZER;
+    FF_ONCE(&once)
         error = doInitCom();
     return error;
 }